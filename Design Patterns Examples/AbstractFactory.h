@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GenericFactory.h"
+#include "Instrumentation.h"
+
+//
+// ===========================
+// Abstract Factory Pattern
+// ===========================
+//
+// Intent: Provide an interface for creating families of related or dependent
+// objects without specifying their concrete classes.
+//
+// Key Roles:
+// - AbstractFactory: declares interfaces for each product type
+// - ConcreteFactory: implements creation for a product family
+// - AbstractProduct: declares product interfaces
+// - ConcreteProduct: product implementations that belong to a family
+//
+
+// ---------- Abstract Product ----------
+class Chair {
+public:
+    virtual std::string type() const = 0;
+
+    // Batch entry point: every item must share the dynamic type of *this
+    virtual void typeAll(const Chair* const* items, std::size_t count,
+                         std::vector<std::string>& out) const {
+        for (std::size_t i = 0; i < count; ++i)
+            out.push_back(items[i]->type());
+    }
+
+    virtual ~Chair() = default;
+};
+
+// ---------- Concrete Products ----------
+class VictorianChair : public Chair {
+public:
+    std::string type() const override { return "Victorian Chair"; }
+
+    void typeAll(const Chair* const* items, std::size_t count,
+                 std::vector<std::string>& out) const override {
+        for (std::size_t i = 0; i < count; ++i)
+            out.push_back(static_cast<const VictorianChair*>(items[i])->VictorianChair::type());
+    }
+};
+
+class ModernChair : public Chair {
+public:
+    std::string type() const override { return "Modern Chair"; }
+
+    void typeAll(const Chair* const* items, std::size_t count,
+                 std::vector<std::string>& out) const override {
+        for (std::size_t i = 0; i < count; ++i)
+            out.push_back(static_cast<const ModernChair*>(items[i])->ModernChair::type());
+    }
+};
+
+template <>
+struct CreationHook<VictorianChair> {
+    static void created() {
+        DP_PROBE1(create_chair, "Victorian");
+        factoryMetrics().victorianChairsCreated.add();
+    }
+};
+
+template <>
+struct CreationHook<ModernChair> {
+    static void created() {
+        DP_PROBE1(create_chair, "Modern");
+        factoryMetrics().modernChairsCreated.add();
+    }
+};
+
+using ChairFactory = Factory<Chair, std::string>;
+
+// ---------- Abstract Factory Interface ----------
+class FurnitureFactory {
+public:
+    virtual Chair* createChair() const = 0;
+    virtual ~FurnitureFactory() = default;
+};
+
+// ---------- Concrete Factories ----------
+// Heap-created products are released to the caller, who deletes them.
+// Product names the concrete chair of the family, for typed storage.
+class VictorianFactory : public FurnitureFactory {
+public:
+    using Product = VictorianChair;
+    Chair* createChair() const override { return ChairFactory::make<Product>().release(); }
+};
+
+class ModernFactory : public FurnitureFactory {
+public:
+    using Product = ModernChair;
+    Chair* createChair() const override { return ChairFactory::make<Product>().release(); }
+};
+
+// ---------- Client Code ----------
+inline void showFurniture(const FurnitureFactory& factory) {
+    LatencyTimer timer(factoryMetrics().showFurnitureLatency);
+    // Client only depends on abstract interfaces
+    std::unique_ptr<Chair> c(factory.createChair());
+    std::cout << "[Abstract Factory] Created: " << c->type() << "\n";
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "AbstractFactory.h"
+#include "FactoryMethod.h"
+
+//
+// ===========================
+// Batch Dispatch
+// ===========================
+//
+// Intent: Pay one virtual call per run of same-typed products instead of one
+// per product. The run is handed to the first product's batch entry point,
+// whose loop calls the concrete implementation directly.
+//
+// deliverRuns/typeRuns find the runs themselves, which reads each item's
+// type info once. Callers that already hold products grouped by type (one
+// container per concrete type, say) use deliverRun/typeRun and skip that
+// per-item load entirely.
+//
+
+// Splits items into runs of equal dynamic type and dispatches each run once
+template <class Product, class BatchCall>
+void dispatchRuns(const std::vector<const Product*>& items, BatchCall batch) {
+    std::size_t start = 0;
+    while (start < items.size()) {
+        const std::type_info& runType = typeid(*items[start]);
+        std::size_t end = start + 1;
+        while (end < items.size() && typeid(*items[end]) == runType)
+            ++end;
+        batch(*items[start], &items[start], end - start);
+        start = end;
+    }
+}
+
+inline std::vector<std::string> deliverRuns(const std::vector<const Transport*>& items) {
+    std::vector<std::string> out;
+    out.reserve(items.size());
+    dispatchRuns(items, [&out](const Transport& first, const Transport* const* run, std::size_t n) {
+        first.deliverAll(run, n, out);
+    });
+    return out;
+}
+
+inline std::vector<std::string> typeRuns(const std::vector<const Chair*>& items) {
+    std::vector<std::string> out;
+    out.reserve(items.size());
+    dispatchRuns(items, [&out](const Chair& first, const Chair* const* run, std::size_t n) {
+        first.typeAll(run, n, out);
+    });
+    return out;
+}
+
+// ---------- Caller-Grouped Runs ----------
+// Every item in the run must share one dynamic type
+inline void deliverRun(const Transport* const* run, std::size_t count, std::vector<std::string>& out) {
+    if (count > 0)
+        run[0]->deliverAll(run, count, out);
+}
+
+inline void typeRun(const Chair* const* run, std::size_t count, std::vector<std::string>& out) {
+    if (count > 0)
+        run[0]->typeAll(run, count, out);
+}
@@ -0,0 +1,858 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+#include "AbstractFactory.h"
+#include "BatchDispatch.h"
+#include "Builder.h"
+#include "CityBuilder.h"
+#include "CompactArena.h"
+#include "ConcurrentHouse.h"
+#include "DeliveryManifest.h"
+#include "FactoryMethod.h"
+#include "FanOutBuilder.h"
+#include "GenericFactory.h"
+#include "HouseRenderer.h"
+#include "IdleTrimmer.h"
+#include "Instrumentation.h"
+#include "JsonWriter.h"
+#include "OrderIngestion.h"
+#include "ProductPools.h"
+#include "ReadyBuffer.h"
+#include "RecipeTracker.h"
+#include "SamplingProfiler.h"
+#include "SlotMap.h"
+#include "SpeculativeBuild.h"
+#include "TaggedPtr.h"
+#include "TrainingWorkload.h"
+#include "TrivialProducts.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+//
+// ===========================
+// Benchmarks
+// ===========================
+//
+// Wall-clock timings of the creational hot paths, one line per case:
+//     <name> <ns per operation>
+// Pass a scale factor (default 1) to run every case longer.
+//
+// On Linux, set DP_PROFILE=<file> to sample every case with the SIGPROF
+// profiler; folded stacks are appended to <file>, each rooted at its case
+// name, ready for flamegraph.pl.
+//
+
+static volatile std::size_t sink; // Keeps results observable
+
+#if defined(__linux__)
+static std::ofstream* profileOut = nullptr; // Set from DP_PROFILE
+#endif
+
+// Returns the elapsed nanoseconds
+template <class F>
+double run(const char* name, std::size_t operations, F body) {
+#if defined(__linux__)
+    std::unique_ptr<ProfileScope> profile;
+    if (profileOut) {
+        std::string frame(name);
+        std::replace(frame.begin(), frame.end(), ' ', '_');
+        profile.reset(new ProfileScope(*profileOut, 997, frame));
+    }
+#endif
+    auto start = std::chrono::steady_clock::now();
+    body();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+#if defined(__linux__)
+    profile.reset(); // Symbolising is not part of the case
+#endif
+    std::printf("%-36s %10.1f ns/op\n", name, elapsed.count() / operations);
+    return elapsed.count();
+}
+
+static void throughput(const char* name, std::size_t bytes, double nanoseconds) {
+    std::printf("%-36s %10.2f GB/s\n", name, bytes / nanoseconds);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// Runs body in a forked child, so it sees the heap as it was at startup
+// rather than one already warmed by earlier cases
+template <class F>
+void inFreshProcess(F body) {
+    std::fflush(stdout);
+    pid_t child = ::fork();
+    if (child == 0) {
+        body();
+        std::fflush(stdout);
+#if defined(__linux__)
+        if (profileOut)
+            profileOut->flush();
+#endif
+        ::_exit(0);
+    }
+    if (child > 0)
+        ::waitpid(child, nullptr, 0);
+}
+#endif
+
+int main(int argc, char* argv[]) {
+    std::size_t scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1;
+    const std::size_t n = 1000000 * (scale ? scale : 1);
+#if defined(__linux__)
+    std::ofstream profileFile;
+    if (const char* path = std::getenv("DP_PROFILE")) {
+        profileFile.open(path, std::ios::app);
+        if (!profileFile) {
+            std::fprintf(stderr, "cannot open DP_PROFILE file %s\n", path);
+            return 1;
+        }
+        profileOut = &profileFile;
+    }
+#endif
+
+    // ==== Startup ====
+#if defined(__unix__) || defined(__APPLE__)
+    // The first requests after a restart, each keeping its truck and house
+    // alive, on the startup heap with and without prewarmProducts()
+    const std::size_t firstRequests = 10000;
+    auto firstRequestsCase = [&](const char* name, bool prewarm) {
+        inFreshProcess([&] {
+            if (prewarm) {
+                PrewarmConfig warm;
+                warm.transports = firstRequests;
+                warm.houses = firstRequests;
+                prewarmProducts(warm);
+            }
+            RoadLogistics logistics;
+            SimpleHouseBuilder builder;
+            Director director;
+            director.setBuilder(&builder);
+            std::vector<std::unique_ptr<Transport>> transports;
+            std::vector<std::unique_ptr<House>> houses;
+            transports.reserve(firstRequests);
+            houses.reserve(firstRequests);
+            run(name, firstRequests, [&] {
+                for (std::size_t i = 0; i < firstRequests; ++i) {
+                    transports.emplace_back(logistics.createTransport());
+                    director.buildFullHouse();
+                    houses.emplace_back(builder.getResult());
+                }
+            });
+            sink = transports.size() + houses.size();
+        });
+    };
+    firstRequestsCase("first 10k requests, cold heap", false);
+    firstRequestsCase("first 10k requests, prewarmed", true);
+#endif
+
+    // ==== Creation ====
+    RoadLogistics road;
+    SeaLogistics sea;
+    run("factory method create+deliver", n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            std::unique_ptr<Transport> t(road.createTransport());
+            sink = t->deliver().size();
+        }
+    });
+
+    // Policy combinations: creation by type, and by key with each lock
+    auto byType = [&](const char* name, auto factory) {
+        using F = decltype(factory);
+        run(name, n, [&] {
+            for (std::size_t i = 0; i < n; ++i)
+                sink = F::template make<Truck>() != nullptr;
+        });
+    };
+    auto byKey = [&](const char* name, auto& factory) {
+        factory.template registerType<Truck>("road");
+        run(name, n, [&] {
+            for (std::size_t i = 0; i < n; ++i)
+                sink = factory.create("road") != nullptr;
+        });
+    };
+    byType("generic make<Truck>, heap", TransportFactory());
+    byType("generic make<Truck>, pooled", PooledTransportFactory());
+    TransportFactory heapFactory;
+    Factory<Transport, std::string, HeapCreation, MutexLocked> lockedHeapFactory;
+    PooledTransportFactory pooledFactory;
+    Factory<Transport, std::string, PooledCreation, MutexLocked> lockedPooledFactory;
+    byKey("generic create(key), heap", heapFactory);
+    byKey("generic create(key), heap+mutex", lockedHeapFactory);
+    byKey("generic create(key), pooled", pooledFactory);
+    byKey("generic create(key), pooled+mutex", lockedPooledFactory);
+
+    // ==== Tracepoints ====
+    // The same loop with and without a USDT probe site. Detached, a probe is
+    // one nop, so the two should match; configure with -DDP_PROBES=OFF to
+    // compare every other case with all probes compiled out.
+    run("loop without probe", n, [&] {
+        for (std::size_t i = 0; i < n; ++i)
+            sink = i;
+    });
+    run("loop with detached probe", n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            DP_PROBE1(bench_tick, i);
+            sink = i;
+        }
+    });
+
+    // ==== Dispatch ====
+    std::vector<std::unique_ptr<Transport>> owned;
+    std::vector<const Transport*> fleet;
+    std::vector<TaggedTransport> tagged;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i % 1000 < 500) {
+            Truck* t = new Truck();
+            owned.emplace_back(t);
+            tagged.push_back(TaggedTransport::make(t));
+        } else {
+            Ship* s = new Ship();
+            owned.emplace_back(s);
+            tagged.push_back(TaggedTransport::make(s));
+        }
+        fleet.push_back(owned.back().get());
+    }
+
+    run("virtual deliver per item", n, [&] {
+        std::vector<std::string> out;
+        out.reserve(fleet.size());
+        for (const Transport* t : fleet)
+            out.push_back(t->deliver());
+        sink = out.size();
+    });
+
+    // Run-length sweep: per-item virtual calls, runs found by deliverRuns,
+    // and runs the caller already knows (deliverRun)
+    for (std::size_t runLength : { 1, 10, 100, 1000, 10000 }) {
+        std::vector<std::unique_ptr<Transport>> sweepOwned;
+        std::vector<const Transport*> sweep;
+        for (std::size_t i = 0; i < n; ++i) {
+            sweepOwned.emplace_back(i / runLength % 2 ? static_cast<Transport*>(new Ship()) : new Truck());
+            sweep.push_back(sweepOwned.back().get());
+        }
+        char name[3][64];
+        std::snprintf(name[0], sizeof(name[0]), "runs of %zu: virtual per item", runLength);
+        std::snprintf(name[1], sizeof(name[1]), "runs of %zu: deliverRuns", runLength);
+        std::snprintf(name[2], sizeof(name[2]), "runs of %zu: deliverRun, grouped", runLength);
+        run(name[0], n, [&] {
+            std::vector<std::string> out;
+            out.reserve(sweep.size());
+            for (const Transport* t : sweep)
+                out.push_back(t->deliver());
+            sink = out.size();
+        });
+        run(name[1], n, [&] {
+            sink = deliverRuns(sweep).size();
+        });
+        run(name[2], n, [&] {
+            std::vector<std::string> out;
+            out.reserve(sweep.size());
+            for (std::size_t start = 0; start < sweep.size(); start += runLength)
+                deliverRun(&sweep[start], std::min(runLength, sweep.size() - start), out);
+            sink = out.size();
+        });
+    }
+
+    run("deliverTagged per item", n, [&] {
+        std::vector<std::string> out;
+        out.reserve(tagged.size());
+        for (TaggedTransport t : tagged)
+            out.push_back(deliverTagged(t));
+        sink = out.size();
+    });
+
+    // Cold products: scattered across the heap, visited in shuffled order
+    // and evicted from the cache before each pass, so every object load
+    // misses. Tagged type tests and dispatch never load the object.
+    {
+        std::vector<std::unique_ptr<char[]>> spacers;
+        std::vector<std::unique_ptr<Transport>> coldOwned;
+        for (std::size_t i = 0; i < n; ++i) {
+            spacers.emplace_back(new char[128]);
+            coldOwned.emplace_back(i % 3 ? static_cast<Transport*>(new Truck()) : new Ship());
+        }
+        std::shuffle(coldOwned.begin(), coldOwned.end(), std::mt19937(42));
+        std::vector<const Transport*> coldFleet;
+        std::vector<TaggedTransport> coldTagged;
+        for (const auto& t : coldOwned) {
+            coldFleet.push_back(t.get());
+            if (const Truck* truck = dynamic_cast<const Truck*>(t.get()))
+                coldTagged.push_back(TaggedTransport::make(const_cast<Truck*>(truck)));
+            else
+                coldTagged.push_back(TaggedTransport::make(static_cast<Ship*>(t.get())));
+        }
+        std::vector<char> flush(64 << 20);
+        auto evict = [&flush] {
+            for (std::size_t i = 0; i < flush.size(); i += 64)
+                ++flush[i];
+            sink = flush[0];
+        };
+
+        evict();
+        run("cold: count trucks via typeid", n, [&] {
+            std::size_t total = 0;
+            for (const Transport* t : coldFleet)
+                total += typeid(*t) == typeid(Truck);
+            sink = total;
+        });
+        evict();
+        run("cold: count trucks via tag", n, [&] {
+            std::size_t total = 0;
+            for (TaggedTransport t : coldTagged)
+                total += t.is<Truck>();
+            sink = total;
+        });
+        evict();
+        run("cold: virtual deliver per item", n, [&] {
+            std::size_t total = 0;
+            for (const Transport* t : coldFleet)
+                total += t->deliver().size();
+            sink = total;
+        });
+        evict();
+        run("cold: deliverTagged per item", n, [&] {
+            std::size_t total = 0;
+            for (TaggedTransport t : coldTagged)
+                total += deliverTagged(t).size();
+            sink = total;
+        });
+    }
+
+    // ==== Storage ====
+    SlotMap<Truck> trucks;
+    std::vector<std::unique_ptr<Truck>> heapTrucks;
+    for (std::size_t i = 0; i < n; ++i) {
+        createInto(trucks);
+        heapTrucks.emplace_back(new Truck());
+    }
+
+    run("iterate vector<unique_ptr<Truck>>", n, [&] {
+        std::size_t total = 0;
+        for (const auto& t : heapTrucks)
+            total += t->Truck::deliver().size();
+        sink = total;
+    });
+
+    run("iterate SlotMap<Truck>", n, [&] {
+        std::size_t total = 0;
+        for (const Truck& t : trucks)
+            total += t.Truck::deliver().size();
+        sink = total;
+    });
+
+    // Houses after churn: half of them replaced in random order. The slot
+    // map stays dense; the heap houses end up scattered. partCount() reads
+    // the product itself, so layout is what is measured.
+    {
+        House full;
+        full.addPart("Walls");
+        full.addPart("Doors");
+        SlotMap<House> churned;
+        std::vector<std::unique_ptr<House>> churnedHeap;
+        std::vector<SlotHandle> handles;
+        for (std::size_t i = 0; i < n; ++i) {
+            handles.push_back(churned.emplace(full));
+            churnedHeap.emplace_back(new House(full));
+        }
+        std::mt19937 rng(7);
+        for (std::size_t i = 0; i < n / 2; ++i) {
+            std::size_t victim = rng() % n;
+            churned.erase(handles[victim]);
+            handles[victim] = churned.emplace(full);
+            std::swap(churnedHeap[rng() % n], churnedHeap.back()); // Erase a random one by swap-and-pop
+            churnedHeap.pop_back();
+            churnedHeap.emplace_back(new House(full));
+        }
+        run("iterate heap Houses, churned", n, [&] {
+            std::size_t total = 0;
+            for (const auto& h : churnedHeap)
+                total += h->partCount();
+            sink = total;
+        });
+        run("iterate SlotMap<House>, churned", n, [&] {
+            std::size_t total = 0;
+            for (const House& h : churned)
+                total += h.partCount();
+            sink = total;
+        });
+    }
+
+    // Catalog of n references to n/16 chairs: 32-bit offsets vs pointers.
+    // The scan resolves every reference to its product's position.
+    CompactArena<ModernChair> chairArena;
+    chairArena.reserve(n / 16 + 1);
+    ModernFactory modernFactory;
+    std::vector<CompactRef<ModernChair>> chairRefs;
+    for (std::size_t i = 0; i <= n / 16; ++i)
+        chairRefs.push_back(createChairInto(modernFactory, chairArena));
+    const ModernChair* chairBase = &chairArena[chairRefs[0]];
+    std::vector<CompactRef<ModernChair>> catalogRefs;
+    std::vector<const ModernChair*> catalogPointers;
+    for (std::size_t i = 0; i < n; ++i) {
+        CompactRef<ModernChair> ref = chairRefs[(i * 2654435761u) % chairRefs.size()];
+        catalogRefs.push_back(ref);
+        catalogPointers.push_back(&chairArena[ref]);
+    }
+    std::printf("%-36s %10.1f MB\n", "catalog footprint, CompactRef",
+                catalogRefs.size() * sizeof(CompactRef<ModernChair>) / 1e6);
+    std::printf("%-36s %10.1f MB\n", "catalog footprint, pointer",
+                catalogPointers.size() * sizeof(const ModernChair*) / 1e6);
+    double refScan = run("scan catalog, CompactRef", n, [&] {
+        std::size_t total = 0;
+        for (CompactRef<ModernChair> ref : catalogRefs)
+            total += static_cast<std::size_t>(&chairArena[ref] - chairBase);
+        sink = total;
+    });
+    throughput("scan catalog, CompactRef", catalogRefs.size() * sizeof(CompactRef<ModernChair>), refScan);
+    double pointerScan = run("scan catalog, pointer", n, [&] {
+        std::size_t total = 0;
+        for (const ModernChair* chair : catalogPointers)
+            total += static_cast<std::size_t>(chair - chairBase);
+        sink = total;
+    });
+    throughput("scan catalog, pointer", catalogPointers.size() * sizeof(const ModernChair*), pointerScan);
+
+    // Long-running store: a resident base plus bursts that come and go. Each
+    // cycle reports RSS at the peak, once the burst is erased, and after an
+    // idle-time compact() and release of free heap pages
+    {
+        House full;
+        full.addPart("Walls");
+        full.addPart("Doors");
+        full.addPart("Windows");
+        SlotMap<House> store;
+        for (std::size_t i = 0; i < n / 20; ++i)
+            store.emplace(full);
+        std::vector<SlotHandle> burst;
+        for (int cycle = 1; cycle <= 4; ++cycle) {
+            burst.clear();
+            for (std::size_t i = 0; i < n; ++i)
+                burst.push_back(store.emplace(full));
+            double peak = residentSetBytes() / 1e6;
+            for (SlotHandle h : burst)
+                store.erase(h);
+            double idle = residentSetBytes() / 1e6;
+            SlotMap<House>::Report before = store.report();
+            store.compact();
+            releaseFreeHeapPages();
+            SlotMap<House>::Report after = store.report();
+            std::printf("slot map churn, cycle %d: RSS %.1f MB peak, %.1f MB idle, %.1f MB compacted;"
+                        " fragmentation %.2f -> %.2f, slots %zu -> %zu\n",
+                        cycle, peak, idle, residentSetBytes() / 1e6, before.fragmentation,
+                        after.fragmentation, before.slots, after.slots);
+        }
+    }
+
+    // Day/night: each day's burst holds pooled trucks and arena houses, then
+    // lets them go. Day 2 reuses what day 1 grew; the night's idle poll trims
+    // the pool and the arena, so the morning pays to grow them again.
+    {
+        TrivialArena arena;
+        IdleTrimmer trimmer(std::chrono::minutes(5));
+        trimmer.watchPool<Truck>(256);
+        trimmer.watchArena(arena, 1);
+        std::vector<PooledTransportFactory::Pointer> trucks;
+        trucks.reserve(n / 4);
+        double dayPeak = 0;
+        auto day = [&](const char* name) {
+            run(name, n / 2, [&] {
+                for (std::size_t i = 0; i < n / 4; ++i) {
+                    trucks.push_back(PooledTransportFactory::make<Truck>());
+                    arena.create<PlainHouse>()->addPart(BuildStep::Walls);
+                }
+            });
+            dayPeak = residentSetBytes() / 1e6;
+            trucks.clear();
+            arena.reset();
+        };
+        day("day 1 burst, growing, per product");
+        day("day 2 burst, warm, per product");
+        double evening = residentSetBytes() / 1e6;
+        IdleTrimmer::Clock::time_point dusk = IdleTrimmer::Clock::now();
+        trimmer.poll(dusk);
+        std::size_t trimmed = trimmer.poll(dusk + std::chrono::hours(8));
+        std::printf("day/night: RSS %.1f MB at peak, %.1f MB idle, %.1f MB after night trim"
+                    " (%zu targets, %.1f MB released)\n",
+                    dayPeak, evening, residentSetBytes() / 1e6, trimmed,
+                    trimmer.lastReleasedBytes() / 1e6);
+        day("morning burst, re-warm, per product");
+    }
+
+    // ==== Builder ====
+    SimpleHouseBuilder builder;
+    Director director;
+    director.setBuilder(&builder);
+    run("director full house", n, [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            director.buildFullHouse();
+            std::unique_ptr<House> h(builder.getResult());
+            sink = h->partCount();
+        }
+    });
+
+    // A House object, text bytes and a stats record for every house
+    {
+        SimpleHouseBuilder objects;
+        HouseTextBuilder text;
+        HouseStatsBuilder stats;
+        run("3 representations, separate passes", n, [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                director.setBuilder(&objects);
+                director.buildFullHouse();
+                std::unique_ptr<House> h(objects.getResult());
+                director.setBuilder(&text);
+                director.buildFullHouse();
+                text.finishHouse();
+                director.setBuilder(&stats);
+                director.buildFullHouse();
+                stats.finishHouse();
+                sink = h->partCount();
+            }
+        });
+    }
+    {
+        SimpleHouseBuilder objects;
+        HouseTextBuilder text;
+        HouseStatsBuilder stats;
+        FanOutBuilder everything(objects, { &text, &stats });
+        director.setBuilder(&everything);
+        run("3 representations, FanOutBuilder", n, [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                director.buildFullHouse();
+                std::unique_ptr<House> h(everything.getResult());
+                sink = h->partCount();
+            }
+        });
+    }
+    {
+        SimpleHouseBuilder objects;
+        HouseTextBuilder text;
+        HouseStatsBuilder stats;
+        auto everything = fanOut(objects, text, stats);
+        director.setBuilder(&everything);
+        run("3 representations, StaticFanOut", n, [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                director.buildFullHouse();
+                std::unique_ptr<House> h(everything.getResult());
+                sink = h->partCount();
+            }
+        });
+    }
+    director.setBuilder(&builder);
+
+    // Incremental rebuilds on n houses spread over 10 recipes; each edit
+    // touches one recipe, i.e. a tenth of the houses
+    {
+        RecipeTracker tracker;
+        const Recipe full{ BuildStep::Walls, BuildStep::Doors, BuildStep::Windows };
+        std::vector<std::string> names;
+        for (int r = 0; r < 10; ++r) {
+            names.push_back("recipe-" + std::to_string(r));
+            tracker.defineRecipe(names.back(), full);
+        }
+        run("recipe tracker, build per house", n, [&] {
+            for (std::size_t i = 0; i < n; ++i)
+                sink = tracker.build(names[i % 10]);
+        });
+        const std::size_t affected = (n + 9) / 10;
+        run("recipe edit, last step, per house", affected, [&] {
+            sink = tracker.updateRecipe(names[0], { BuildStep::Walls, BuildStep::Doors, BuildStep::Doors });
+        });
+        run("recipe edit, first step, per house", affected, [&] {
+            sink = tracker.updateRecipe(names[1], { BuildStep::Doors, BuildStep::Doors, BuildStep::Windows });
+        });
+        run("full rebuild of affected, per house", affected, [&] {
+            for (std::size_t i = 0; i < affected; ++i) {
+                director.build(full);
+                std::unique_ptr<House> h(builder.getResult());
+                sink = h->partCount();
+            }
+        });
+        // Untracked baselines: n houses built in place into one vector, then
+        // a tenth of them rebuilt from scratch in place
+        std::vector<House> plain(n);
+        InPlaceHouseBuilder inPlace;
+        director.setBuilder(&inPlace);
+        run("plain director, build per house", n, [&] {
+            for (House& h : plain) {
+                inPlace.setTarget(&h);
+                director.build(full);
+                inPlace.finishHouse();
+            }
+        });
+        run("full rebuild in place, per house", affected, [&] {
+            for (std::size_t i = 0; i < n; i += 10) {
+                plain[i].truncate(0);
+                inPlace.setTarget(&plain[i]);
+                director.build(full);
+                inPlace.finishHouse();
+            }
+        });
+        director.setBuilder(&builder);
+    }
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    run("city builder, per house (all threads)", n, [&] {
+        CityBuilder city(n / 1000, 1000);
+        std::unique_ptr<City> c(city.build(threads));
+        sink = c->houseCount();
+    });
+
+    // 10M houses (x scale): throughput and resident memory of the city
+    {
+        const std::size_t cityHouses = 10 * n;
+        std::size_t before = residentSetBytes();
+        std::unique_ptr<City> bigCity;
+        double ns = run("city builder, 10M houses", cityHouses, [&] {
+            bigCity.reset(CityBuilder(cityHouses / 1000, 1000).build(threads));
+        });
+        std::size_t grown = residentSetBytes() - before;
+        std::printf("%-36s %10.2f M houses/s\n", "city builder, 10M houses", bigCity->houseCount() / ns * 1e3);
+        std::printf("%-36s %10.1f MB (%zu bytes/house)\n", "city builder, 10M houses, RSS",
+                    grown / 1e6, grown / bigCity->houseCount());
+    }
+
+    // 1 to 64 threads appending into one ConcurrentHouse (finalize included)
+    const std::size_t appends = n < ConcurrentHouse::maxParts ? n : ConcurrentHouse::maxParts;
+    for (unsigned writers : { 1u, 2u, 4u, 8u, 16u, 32u, 64u }) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "concurrent house, %u threads", writers);
+        run(name, appends, [&] {
+            ConcurrentHouse shared;
+            std::vector<std::thread> pool;
+            for (unsigned w = 0; w < writers; ++w)
+                pool.emplace_back([&shared, w, writers, appends] {
+                    for (std::size_t i = w; i < appends; i += writers)
+                        shared.addPart(w, "Walls");
+                });
+            for (auto& t : pool)
+                t.join();
+            std::unique_ptr<House> h(shared.finalize());
+            sink = h->partCount();
+        });
+    }
+
+    // ==== Rendering ====
+    std::vector<House> streetOfHouses;
+    for (std::size_t i = 0; i < n; ++i) {
+        director.buildFullHouse();
+        std::unique_ptr<House> h(builder.getResult());
+        streetOfHouses.push_back(std::move(*h));
+    }
+    std::size_t renderedBytes = 0;
+    double parallelTime = run("render houses (all threads)", n, [&] {
+        renderedBytes = renderHouses(streetOfHouses, threads).size();
+    });
+    throughput("render houses (all threads)", renderedBytes, parallelTime);
+    double serialTime = run("render houses (1 thread)", n, [&] {
+        renderedBytes = renderHouses(streetOfHouses, 1).size();
+    });
+    throughput("render houses (1 thread)", renderedBytes, serialTime);
+    sink = renderedBytes;
+
+    // ==== JSON ====
+    std::size_t jsonBytes = 0;
+    double streamTime = run("json houses via ostringstream", n, [&] {
+        std::ostringstream out;
+        for (const House& h : streetOfHouses) {
+            out << "{\"parts\":[";
+            bool firstPart = true;
+            for (const auto& part : h.getParts()) {
+                out << (firstPart ? "" : ",") << '"' << part << '"';
+                firstPart = false;
+            }
+            out << "]}\n";
+        }
+        jsonBytes = out.str().size();
+    });
+    throughput("json houses via ostringstream", jsonBytes, streamTime);
+
+    JsonWriter json;
+    double writerTime = run("json houses via JsonWriter", n, [&] {
+        json.clear();
+        for (const House& h : streetOfHouses)
+            writeJson(json, h);
+        jsonBytes = json.str().size();
+    });
+    throughput("json houses via JsonWriter", jsonBytes, writerTime);
+    sink = jsonBytes;
+
+    // ==== Delivery Planning ====
+    // Plan one batch over every order in a buffer: views into the buffer vs a
+    // copy of each payload. Rate is order bytes planned per second.
+    {
+        std::string text;
+        for (std::size_t i = 0; i < n / 10; ++i)
+            text += "order " + std::to_string(i) + ": 20 crates of assorted furniture, dock 7\n";
+        OrderBuffer buffer(text);
+        RoadLogistics planner;
+        const std::size_t rounds = 10;
+        double viewTime = run("plan batch, views, per order", rounds * buffer.orders().size(), [&] {
+            for (std::size_t r = 0; r < rounds; ++r)
+                sink = planBatch(planner, buffer).payloadBytes();
+        });
+        double copyTime = run("plan batch, copied payloads, per order", rounds * buffer.orders().size(), [&] {
+            for (std::size_t r = 0; r < rounds; ++r) {
+                std::unique_ptr<Transport> transport(planner.createTransport());
+                std::vector<std::string> copies;
+                for (const PayloadView& order : buffer.orders())
+                    copies.push_back(order.str());
+                sink = copies.size();
+            }
+        });
+        std::printf("%-36s %10.1f MB/s\n", "plan batch, views", rounds * buffer.bytes() / viewTime * 1e3);
+        std::printf("%-36s %10.1f MB/s\n", "plan batch, copied payloads", rounds * buffer.bytes() / copyTime * 1e3);
+    }
+
+    // ==== Order Ingestion ====
+    std::string orderLines;
+    for (std::size_t i = 0; i < n; ++i)
+        orderLines += "{\"id\":\"o-" + std::to_string(i) + "\",\"mode\":\""
+            + (i % 3 ? "road" : "sea") + "\",\"payload\":\"20 crates of assorted furniture\"}\n";
+    PayloadOwner orderLinesOwner;
+    std::size_t planned = 0;
+    double ingestTime = run("ingest json-lines orders", n, [&] {
+        OrderBatches batches = ingestOrders(orderLines.data(), orderLines.size(), orderLinesOwner);
+        planned = planBatch(road, batches.road).orders.size() + planBatch(sea, batches.sea).orders.size();
+    });
+    throughput("ingest json-lines orders", orderLines.size(), ingestTime);
+    std::printf("%-36s %10.2f M orders/s\n", "ingest json-lines orders", planned / ingestTime * 1e3);
+    if (argc > 2) { // Optional real input: dp_bench <scale> <orders.jsonl>
+        MappedFile orderFile(argv[2]);
+        double fileTime = run("ingest mapped json-lines file", 1, [&] {
+            OrderBatches batches = ingestOrders(orderFile);
+            planned = planBatch(road, batches.road).orders.size() + planBatch(sea, batches.sea).orders.size();
+        });
+        throughput("ingest mapped json-lines file", orderFile.size(), fileTime);
+        std::printf("%-36s %10.2f M orders/s\n", "ingest mapped json-lines file", planned / fileTime * 1e3);
+    }
+    sink = planned;
+
+    // ==== Trivial Products ====
+    House sampleHouse;
+    sampleHouse.addPart("Walls");
+    sampleHouse.addPart("Doors");
+    sampleHouse.addPart("Windows");
+    run("vector<House> growth", n, [&] {
+        std::vector<House> houses;
+        for (std::size_t i = 0; i < n; ++i)
+            houses.push_back(sampleHouse);
+        sink = houses.size();
+    });
+
+    PlainHouse samplePlain = {};
+    samplePlain.addPart(BuildStep::Walls);
+    samplePlain.addPart(BuildStep::Doors);
+    samplePlain.addPart(BuildStep::Windows);
+    run("TrivialVector<PlainHouse> growth", n, [&] {
+        TrivialVector<PlainHouse> houses;
+        for (std::size_t i = 0; i < n; ++i)
+            houses.push_back(samplePlain);
+        sink = houses.size();
+    });
+
+    std::vector<std::unique_ptr<House>> heapHouses;
+    for (std::size_t i = 0; i < n; ++i)
+        heapHouses.emplace_back(new House(sampleHouse));
+    run("teardown: delete each House", n, [&] {
+        heapHouses.clear();
+    });
+
+    TrivialArena arena;
+    for (std::size_t i = 0; i < n; ++i)
+        arena.create<PlainHouse>(samplePlain);
+    run("teardown: TrivialArena::reset", n, [&] {
+        arena.reset();
+    });
+
+    // ==== Speculative Builds ====
+    const Recipe variants[] = {
+        { BuildStep::Walls, BuildStep::Doors },
+        { BuildStep::Walls, BuildStep::Doors, BuildStep::Windows },
+        { BuildStep::Walls, BuildStep::Windows, BuildStep::Windows, BuildStep::Doors },
+    };
+    run("variant: SimpleHouseBuilder, discard", n, [&] {
+        SimpleHouseBuilder simple;
+        Director d;
+        d.setBuilder(&simple);
+        for (std::size_t i = 0; i < n; ++i) {
+            d.build(variants[i % 3]);
+            std::unique_ptr<House> h(simple.getResult());
+            sink = h->partCount();
+        }
+    });
+
+    run("variant: ArenaHouseBuilder, rollback", n, [&] {
+        TrivialArena scratch;
+        ArenaHouseBuilder speculative(scratch);
+        Director d;
+        d.setBuilder(&speculative);
+        for (std::size_t i = 0; i < n; ++i) {
+            ArenaHouseBuilder::Checkpoint cp = speculative.checkpoint();
+            d.build(variants[i % 3]);
+            speculative.finishHouse();
+            sink = speculative.houses().back()->partCount;
+            speculative.rollback(cp);
+        }
+    });
+
+    // ==== Speculative Pre-Creation ====
+    // 80/20 road/sea demand against a 64-product ready buffer. Back-to-back
+    // requests leave the filler no time; paced ones yield between requests,
+    // as a service waiting on I/O would. Latency is per acquire only.
+    {
+        const std::size_t requests = n / 10;
+        auto speculative = [&](const char* name, bool paced) {
+            ReadyBuffer<Transport, std::string> buffer(64);
+            buffer.registerType<Truck>("road");
+            buffer.registerType<Ship>("sea");
+            buffer.start();
+            std::this_thread::yield();
+            const std::string road("road"), sea("sea");
+            double total = 0;
+            for (std::size_t i = 0; i < requests; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                ReadyBuffer<Transport, std::string>::Pointer t = buffer.acquire(i % 5 == 4 ? sea : road);
+                total += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                sink = t->deliver().size();
+                if (paced)
+                    std::this_thread::yield();
+            }
+            buffer.stop();
+            std::printf("%-36s %10.1f ns/op, hit rate %.1f%%\n", name, total / requests, 100.0 * buffer.hitRate());
+        };
+        speculative("ready buffer acquire, back-to-back", false);
+        speculative("ready buffer acquire, paced", true);
+        Factory<Transport, std::string, HeapCreation, MutexLocked> direct;
+        direct.registerType<Truck>("road");
+        direct.registerType<Ship>("sea");
+        const std::string road("road"), sea("sea");
+        double total = 0;
+        for (std::size_t i = 0; i < requests; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            auto t = direct.create(i % 5 == 4 ? sea : road);
+            total += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            sink = t->deliver().size();
+        }
+        std::printf("%-36s %10.1f ns/op\n", "direct create(key), same mix", total / requests);
+    }
+
+    // ==== Whole Workload ====
+    run("training workload, per round", n, [&] {
+        runTrainingWorkload(n);
+    });
+
+    return 0;
+}
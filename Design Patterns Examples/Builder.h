@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Instrumentation.h"
+
+//
+// ===========================
+// Builder Pattern
+// ===========================
+//
+// Intent: Separate the construction of a complex object from its representation
+// so the same construction process can create different representations.
+//
+// Key Roles:
+// - Product: complex object being built
+// - Builder: abstract interface defining build steps
+// - ConcreteBuilder: provides step-by-step implementation
+// - Director: controls construction sequence (optional)
+//
+
+class House {
+public:
+    void addPart(const std::string& part) { parts.push_back(part); }
+
+    std::size_t partCount() const { return parts.size(); }
+    const std::vector<std::string>& getParts() const { return parts; }
+
+    // Drop every part after the first n (used when rebuilding a suffix)
+    void truncate(std::size_t n) {
+        if (n < parts.size())
+            parts.erase(parts.begin() + n, parts.end());
+    }
+
+    void append(const House& other) {
+        parts.insert(parts.end(), other.parts.begin(), other.parts.end());
+    }
+
+    // Length of show()'s output, and the same text written to `out`
+    std::size_t describedLength() const {
+        std::size_t n = showPrefixLength + 1; // Prefix and newline
+        for (const auto& p : parts)
+            n += p.size() + 1;
+        return n;
+    }
+
+    char* describeTo(char* out) const {
+        std::memcpy(out, showPrefix(), showPrefixLength);
+        out += showPrefixLength;
+        for (const auto& p : parts) {
+            std::memcpy(out, p.data(), p.size());
+            out += p.size();
+            *out++ = ' ';
+        }
+        *out++ = '\n';
+        return out;
+    }
+
+    void show() const {
+        std::cout << showPrefix();
+        for (const auto& p : parts)
+            std::cout << p << " ";
+        std::cout << "\n";
+    }
+
+private:
+    static const char* showPrefix() { return "[Builder] House with: "; }
+    static const std::size_t showPrefixLength = 22;
+    std::vector<std::string> parts;
+};
+
+// ---------- Step Interface ----------
+// What Director drives. finishHouse() closes the house being built; builders
+// of representations other than a House object implement only this.
+class HouseStepBuilder {
+public:
+    virtual void buildWalls() = 0;
+    virtual void buildDoors() = 0;
+    virtual void buildWindows() = 0;
+    virtual void finishHouse() = 0;
+    virtual ~HouseStepBuilder() = default;
+};
+
+// ---------- Builder Interface ----------
+// getResult() always returns a new House, owned by the caller
+class HouseBuilder : public HouseStepBuilder {
+public:
+    virtual House* getResult() = 0;
+    void finishHouse() override { delete getResult(); }
+};
+
+// ---------- Concrete Builder ----------
+class SimpleHouseBuilder : public HouseBuilder {
+    House* house;
+public:
+    SimpleHouseBuilder() { house = new House(); }
+    ~SimpleHouseBuilder() { delete house; }
+
+    void buildWalls() override {
+        DP_PROBE1(build_step, "Walls");
+        house->addPart("Walls");
+    }
+    void buildDoors() override {
+        DP_PROBE1(build_step, "Doors");
+        house->addPart("Doors");
+    }
+    void buildWindows() override {
+        DP_PROBE1(build_step, "Windows");
+        house->addPart("Windows");
+    }
+
+    House* getResult() override {
+        DP_PROBE1(get_result, house->partCount());
+        House* result = house;
+        house = new House(); // prepare for next build
+        return result;
+    }
+
+    // Speculative building: remember the in-progress house, try some steps,
+    // then drop them again with rollback() if the variant is rejected
+    std::size_t checkpoint() const { return house->partCount(); }
+    void rollback(std::size_t mark) { house->truncate(mark); }
+};
+
+// ---------- In-Place Builder ----------
+// Adds parts straight to a House the caller owns, e.g. one already sitting in
+// its final storage, so nothing is allocated, moved or freed per house
+class InPlaceHouseBuilder : public HouseStepBuilder {
+    House* house = nullptr;
+public:
+    void setTarget(House* h) { house = h; }
+
+    void buildWalls() override {
+        DP_PROBE1(build_step, "Walls");
+        house->addPart("Walls");
+    }
+    void buildDoors() override {
+        DP_PROBE1(build_step, "Doors");
+        house->addPart("Doors");
+    }
+    void buildWindows() override {
+        DP_PROBE1(build_step, "Windows");
+        house->addPart("Windows");
+    }
+
+    void finishHouse() override {
+        DP_PROBE1(get_result, house->partCount());
+        house = nullptr;
+    }
+};
+
+// ---------- Recipe Steps ----------
+enum class BuildStep { Walls, Doors, Windows };
+using Recipe = std::vector<BuildStep>;
+
+// ---------- Director (optional) ----------
+class Director {
+    HouseStepBuilder* builder;
+public:
+    void setBuilder(HouseStepBuilder* b) { builder = b; }
+
+    // Build only essential parts
+    void buildMinimalHouse() {
+        LatencyTimer timer(factoryMetrics().directorLatency);
+        factoryMetrics().housesDirected.add();
+        builder->buildWalls();
+        builder->buildDoors();
+    }
+
+    // Build everything
+    void buildFullHouse() {
+        LatencyTimer timer(factoryMetrics().directorLatency);
+        factoryMetrics().housesDirected.add();
+        builder->buildWalls();
+        builder->buildDoors();
+        builder->buildWindows();
+    }
+
+    // Build from a data-driven recipe; counted and timed as one house
+    void build(const Recipe& recipe) {
+        build(recipe, 0, [](std::size_t) {});
+    }
+
+    // Build recipe[first..] as one house, calling afterStep(i) once step i is
+    // done (e.g. to record how far each step got)
+    template <class AfterStep>
+    void build(const Recipe& recipe, std::size_t first, AfterStep afterStep) {
+        LatencyTimer timer(factoryMetrics().directorLatency);
+        factoryMetrics().housesDirected.add();
+        for (std::size_t i = first; i < recipe.size(); ++i) {
+            build(recipe[i]);
+            afterStep(i);
+        }
+    }
+
+    // A single step of a house being built through the recipe overloads;
+    // not counted as a house on its own
+    void build(BuildStep step) {
+        switch (step) {
+        case BuildStep::Walls: builder->buildWalls(); break;
+        case BuildStep::Doors: builder->buildDoors(); break;
+        case BuildStep::Windows: builder->buildWindows(); break;
+        }
+    }
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Builder.h"
+
+//
+// ===========================
+// City Builder (composite, parallel)
+// ===========================
+//
+// Intent: Build a whole city (blocks of houses) by running Director on
+// several threads at once. Each block is one contiguous allocation sized up
+// front - the block's own arena - and every house is constructed in place in
+// it through an InPlaceHouseBuilder: no House is heap-allocated, moved or
+// freed, and finished blocks are never copied or merged afterwards. (Part
+// buffers inside each House still come from the thread's malloc arena.)
+//
+// Key Roles:
+// - City: the composite product, a list of blocks of houses
+// - CityBuilder: hands blocks out to worker threads, one builder per thread
+//
+// If any worker throws, the others stop at their next house, every thread is
+// joined, and build() rethrows the first exception.
+//
+
+class City {
+public:
+    using Block = std::vector<House>;
+
+    std::size_t blockCount() const { return blocks.size(); }
+    const Block& block(std::size_t i) const { return blocks[i]; }
+
+    std::size_t houseCount() const {
+        std::size_t n = 0;
+        for (const auto& b : blocks)
+            n += b.size();
+        return n;
+    }
+
+private:
+    friend class CityBuilder;
+    std::vector<Block> blocks;
+};
+
+class CityBuilder {
+public:
+    CityBuilder(std::size_t blocks, std::size_t housesPerBlock)
+        : blocks(blocks), housesPerBlock(housesPerBlock) {}
+
+    City* build(unsigned threads = std::thread::hardware_concurrency()) const {
+        std::unique_ptr<City> city(new City());
+        city->blocks.resize(blocks); // Every block has its final address up front
+
+        std::atomic<std::size_t> nextBlock{ 0 };
+        std::atomic<bool> failed{ false };
+        std::exception_ptr failure;
+        std::mutex failureMutex;
+        auto fail = [&] {
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure)
+                failure = std::current_exception();
+            failed.store(true, std::memory_order_relaxed);
+        };
+
+        auto worker = [this, &city, &nextBlock, &failed, &fail] {
+            try {
+                InPlaceHouseBuilder builder; // Builders are not shared between threads
+                Director director;
+                director.setBuilder(&builder);
+                for (std::size_t b; (b = nextBlock.fetch_add(1)) < blocks;) {
+                    City::Block& block = city->blocks[b];
+                    block.reserve(housesPerBlock); // Addresses stay fixed from here on
+                    for (std::size_t i = 0; i < housesPerBlock; ++i) {
+                        if (failed.load(std::memory_order_relaxed))
+                            return;
+                        block.emplace_back();
+                        builder.setTarget(&block.back());
+                        director.buildFullHouse();
+                        builder.finishHouse();
+                    }
+                }
+            } catch (...) {
+                fail();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        try {
+            for (unsigned t = 1; t < std::max(threads, 1u); ++t)
+                pool.emplace_back(worker);
+        } catch (...) { // Could not start a thread: stop the others, rethrow below
+            fail();
+        }
+        if (!failed.load())
+            worker(); // The calling thread builds too
+        for (auto& t : pool)
+            t.join();
+        if (failure)
+            std::rethrow_exception(failure);
+        return city.release();
+    }
+
+private:
+    std::size_t blocks;
+    std::size_t housesPerBlock;
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "AbstractFactory.h"
+#include "Builder.h"
+
+//
+// ===========================
+// Compact Product References
+// ===========================
+//
+// Intent: Refer to products with a 32-bit offset from an arena base instead of
+// a 64-bit pointer, halving the size of large catalogs of references.
+//
+// Key Roles:
+// - CompactArena: append-only contiguous storage for one concrete product type
+// - CompactRef: 32-bit offset into an arena, resolved against that arena
+//
+
+template <class T>
+class CompactArena;
+
+// ---------- Compact Reference ----------
+template <class T>
+class CompactRef {
+public:
+    CompactRef() = default;
+
+    bool isNull() const { return offset == null; }
+
+    // Smart-pointer style access, given the arena the product lives in
+    T* get(CompactArena<T>& arena) const { return isNull() ? nullptr : &arena.at(offset); }
+    const T* get(const CompactArena<T>& arena) const { return isNull() ? nullptr : &arena.at(offset); }
+
+    bool operator==(CompactRef other) const { return offset == other.offset; }
+    bool operator!=(CompactRef other) const { return offset != other.offset; }
+
+private:
+    friend class CompactArena<T>;
+    static const std::uint32_t null = 0xFFFFFFFFu;
+
+    explicit CompactRef(std::uint32_t o) : offset(o) {}
+    std::uint32_t offset = null;
+};
+
+// ---------- Compact Arena ----------
+template <class T>
+class CompactArena {
+public:
+    template <class... Args>
+    CompactRef<T> emplace(Args&&... args) {
+        if (products.size() >= 0xFFFFFFFFu)
+            throw std::length_error("CompactArena: 32-bit offset space exhausted");
+        products.emplace_back(std::forward<Args>(args)...);
+        return CompactRef<T>(static_cast<std::uint32_t>(products.size() - 1));
+    }
+
+    T& operator[](CompactRef<T> ref) { return at(ref.offset); }
+    const T& operator[](CompactRef<T> ref) const { return at(ref.offset); }
+
+    std::size_t size() const { return products.size(); }
+    void reserve(std::size_t n) { products.reserve(n); }
+
+    // Invalidates every reference handed out so far
+    void clear() { products.clear(); }
+
+private:
+    friend class CompactRef<T>;
+
+    T& at(std::uint32_t offset) { return products[offset]; }
+    const T& at(std::uint32_t offset) const { return products[offset]; }
+
+    std::vector<T> products;
+};
+
+// ---------- Creating Products Into Arenas ----------
+// Abstract Factory: construct the chair of the factory's family in place
+// (the factory's Product type), recording it like createChair() does
+template <class ConcreteFactory>
+CompactRef<typename ConcreteFactory::Product>
+createChairInto(const ConcreteFactory&, CompactArena<typename ConcreteFactory::Product>& arena) {
+    CreationHook<typename ConcreteFactory::Product>::created();
+    return arena.emplace();
+}
+
+// Builder: move the finished house into the arena
+inline CompactRef<House> storeHouse(CompactArena<House>& arena, HouseBuilder& builder) {
+    std::unique_ptr<House> house(builder.getResult());
+    return arena.emplace(std::move(*house));
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Builder.h"
+
+//
+// ===========================
+// Concurrent House
+// ===========================
+//
+// Intent: Let several threads contribute parts to the same house. Appends
+// claim a slot with a compare-and-swap on the part count, retried only when
+// another append won the race (and refused once the house is full), then
+// write into fixed-size segments that never move. No thread ever blocks on
+// another.
+//
+// Usage: every contributor calls addPart() with its own contributor id; once
+// all of them are done, finalize() builds an ordinary House. Parts are ordered
+// by contributor id and then by the order each contributor added them, so the
+// result does not depend on thread scheduling, provided each id is used by
+// one thread only. Two threads sharing an id interleave their parts in
+// whatever order their appends happened to claim slots.
+//
+
+class ConcurrentHouse {
+public:
+    ConcurrentHouse() {
+        for (auto& segment : segments)
+            segment.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~ConcurrentHouse() {
+        for (auto& segment : segments)
+            delete[] segment.load(std::memory_order_relaxed);
+    }
+
+    ConcurrentHouse(const ConcurrentHouse&) = delete;
+    ConcurrentHouse& operator=(const ConcurrentHouse&) = delete;
+
+    static const std::size_t maxParts = 256 * 4096;
+
+    // Safe to call from any number of threads at once. Throws
+    // std::length_error once maxParts parts have been added; a part whose
+    // append throws (length_error or bad_alloc) is simply not in the house.
+    void addPart(unsigned contributor, std::string part) {
+        std::size_t index = count.load(std::memory_order_relaxed);
+        do {
+            if (index >= maxParts)
+                throw std::length_error("ConcurrentHouse: too many parts");
+        } while (!count.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+        Slot& slot = segmentFor(index)[index % segmentSize];
+        slot.contributor = contributor;
+        slot.part = std::move(part);
+        slot.written = true;
+    }
+
+    // Call only after every contributing thread has been joined
+    House* finalize() const {
+        std::size_t n = count.load(std::memory_order_acquire);
+        std::vector<const Slot*> ordered;
+        ordered.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const Slot* segment = segments[i / segmentSize].load(std::memory_order_acquire);
+            if (segment && segment[i % segmentSize].written) // Skips appends that threw
+                ordered.push_back(&segment[i % segmentSize]);
+        }
+
+        // Claim order within one contributor is its program order
+        std::stable_sort(ordered.begin(), ordered.end(),
+                         [](const Slot* a, const Slot* b) { return a->contributor < b->contributor; });
+
+        House* house = new House();
+        for (const Slot* slot : ordered)
+            house->addPart(slot->part);
+        return house;
+    }
+
+private:
+    struct Slot {
+        unsigned contributor = 0;
+        bool written = false;
+        std::string part;
+    };
+
+    static const std::size_t segmentSize = 256;
+    static const std::size_t maxSegments = maxParts / segmentSize;
+
+    Slot* segmentFor(std::size_t index) {
+        std::atomic<Slot*>& segment = segments[index / segmentSize];
+        Slot* existing = segment.load(std::memory_order_acquire);
+        if (existing)
+            return existing;
+        Slot* fresh = new Slot[segmentSize];
+        if (segment.compare_exchange_strong(existing, fresh, std::memory_order_acq_rel))
+            return fresh;
+        delete[] fresh; // Another thread installed it first
+        return existing;
+    }
+
+    std::atomic<std::size_t> count{ 0 };
+    std::atomic<Slot*> segments[maxSegments];
+};
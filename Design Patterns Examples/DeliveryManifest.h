@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FactoryMethod.h"
+
+//
+// ===========================
+// Zero-Copy Delivery Manifests
+// ===========================
+//
+// Intent: Let a delivery manifest refer to order payloads where they already
+// live, in a buffer owned by the caller, instead of copying them into every
+// product. Planning a batch copies no payload bytes.
+//
+// Key Roles:
+// - PayloadOwner: anything that owns payload bytes; with lifetime checks on
+//   it holds a liveness token so views can detect that their bytes are gone
+// - PayloadView: pointer + length into an owner's bytes
+// - OrderBuffer: caller-owned buffer of newline-separated orders
+// - DeliveryManifest: one transport plus views of the orders it carries
+//
+// DP_CHECK_PAYLOAD_LIFETIME (default: on unless NDEBUG) only switches the
+// check. Both classes have the same layout either way, so code built with
+// and without it can share these types; views made with checks off are
+// simply not checked.
+//
+
+#ifndef DP_CHECK_PAYLOAD_LIFETIME
+#ifdef NDEBUG
+#define DP_CHECK_PAYLOAD_LIFETIME 0
+#else
+#define DP_CHECK_PAYLOAD_LIFETIME 1
+#endif
+#endif
+
+// ---------- Payload Ownership ----------
+class PayloadOwner {
+public:
+    PayloadOwner() {
+#if DP_CHECK_PAYLOAD_LIFETIME
+        alive = std::make_shared<const int>(0);
+#endif
+    }
+
+    // A copy owns different bytes, so it gets its own token
+    PayloadOwner(const PayloadOwner&) : PayloadOwner() {}
+    PayloadOwner& operator=(const PayloadOwner&) { return *this; }
+
+    // Empty when the owner was built with lifetime checks off
+    std::weak_ptr<const int> token() const { return alive; }
+
+private:
+    std::shared_ptr<const int> alive;
+};
+
+class PayloadView {
+public:
+    PayloadView() = default;
+    PayloadView(const char* data, std::size_t size, const PayloadOwner& owner)
+        : bytes(data), length(size)
+#if DP_CHECK_PAYLOAD_LIFETIME
+        , owner(owner.token())
+#endif
+    {
+        (void)owner;
+    }
+
+    // With lifetime checks on, asserts the owning buffer is still alive
+    const char* data() const {
+#if DP_CHECK_PAYLOAD_LIFETIME
+        assert(!(tracked() && owner.expired()) && "PayloadView outlived the buffer it refers to");
+#endif
+        return bytes;
+    }
+
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    // The one explicit copy, for callers that need to keep the payload
+    std::string str() const { return std::string(data(), length); }
+
+private:
+    // False for default views and for owners built with checks off
+    bool tracked() const {
+        std::weak_ptr<const int> none;
+        return owner.owner_before(none) || none.owner_before(owner);
+    }
+
+    const char* bytes = nullptr;
+    std::size_t length = 0;
+    std::weak_ptr<const int> owner; // Always present: layout must not depend on the check
+};
+
+// ---------- Caller-Owned Orders ----------
+class OrderBuffer : public PayloadOwner {
+public:
+    // Takes the bytes once; every order is a view into them from then on
+    explicit OrderBuffer(std::string text) : text(std::move(text)) {
+        std::size_t start = 0;
+        while (start < this->text.size()) {
+            std::size_t end = this->text.find('\n', start);
+            if (end == std::string::npos)
+                end = this->text.size();
+            if (end > start)
+                views.emplace_back(this->text.data() + start, end - start, *this);
+            start = end + 1;
+        }
+    }
+
+    OrderBuffer(const OrderBuffer&) = delete;
+    OrderBuffer& operator=(const OrderBuffer&) = delete;
+
+    const std::vector<PayloadView>& orders() const { return views; }
+    std::size_t bytes() const { return text.size(); }
+
+private:
+    std::string text;
+    std::vector<PayloadView> views;
+};
+
+// ---------- Manifests ----------
+struct DeliveryManifest {
+    std::unique_ptr<Transport> transport;
+    std::vector<PayloadView> orders;
+
+    std::size_t payloadBytes() const {
+        std::size_t n = 0;
+        for (const auto& order : orders)
+            n += order.size();
+        return n;
+    }
+};
+
+// One transport for the whole batch; the orders are referenced, not copied
+template <class Orders>
+DeliveryManifest planBatch(const Logistics& logistics, const Orders& orders) {
+    DeliveryManifest manifest;
+    manifest.transport.reset(logistics.createTransport());
+    manifest.orders.assign(orders.begin(), orders.end());
+    return manifest;
+}
+
+inline DeliveryManifest planBatch(const Logistics& logistics, const OrderBuffer& buffer) {
+    return planBatch(logistics, buffer.orders());
+}
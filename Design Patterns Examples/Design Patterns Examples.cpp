@@ -1,211 +1,52 @@
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
-#include <memory>
-
-//
-// ===========================
-// Factory Method Pattern
-// ===========================
-//
-// Intent: Define an interface for creating an object, but let subclasses
-// decide which class to instantiate. Factory Method lets a class defer
-// instantiation to subclasses.
-//
-// Key Roles:
-// - Product: common interface for all possible products
-// - ConcreteProduct: specific classes implementing the product
-// - Creator: declares the factory method (can have default implementations)
-// - ConcreteCreator: overrides the factory method to return a ConcreteProduct
-//
-
-// ---------- Product Interface ----------
-class Transport {
-public:
-    virtual std::string deliver() const = 0;
-    virtual ~Transport() = default;
-};
-
-// ---------- Concrete Products ----------
-class Truck : public Transport {
-public:
-    std::string deliver() const override { return "Delivery by Truck"; }
-};
-
-class Ship : public Transport {
-public:
-    std::string deliver() const override { return "Delivery by Ship"; }
-};
-
-// ---------- Creator Interface ----------
-class Logistics {
-public:
-    virtual Transport* createTransport() const = 0; // Factory Method
-    virtual ~Logistics() = default;
-
-    // Template method using the product created by factory method
-    void planDelivery() const {
-        std::unique_ptr<Transport> t(createTransport()); // Decouples creation
-        std::cout << "[Factory Method] " << t->deliver() << "\n";
-    }
-};
-
-// ---------- Concrete Creators ----------
-class RoadLogistics : public Logistics {
-public:
-    Transport* createTransport() const override { return new Truck(); }
-};
-
-class SeaLogistics : public Logistics {
-public:
-    Transport* createTransport() const override { return new Ship(); }
-};
 
+#include "AbstractFactory.h"
+#include "BatchDispatch.h"
+#include "Builder.h"
+#include "CityBuilder.h"
+#include "CompactArena.h"
+#include "ConcurrentHouse.h"
+#include "DeliveryManifest.h"
+#include "FactoryMethod.h"
+#include "FanOutBuilder.h"
+#include "GenericFactory.h"
+#include "HouseRenderer.h"
+#include "IdleTrimmer.h"
+#include "JsonWriter.h"
+#include "MetricsExport.h"
+#include "OrderIngestion.h"
+#include "ProductPools.h"
+#include "ReadyBuffer.h"
+#include "RecipeTracker.h"
+#include "SlotMap.h"
+#include "SpeculativeBuild.h"
+#include "TaggedPtr.h"
+#include "TrainingWorkload.h"
+#include "TrivialProducts.h"
 
 //
 // ===========================
-// Abstract Factory Pattern
-// ===========================
-//
-// Intent: Provide an interface for creating families of related or dependent
-// objects without specifying their concrete classes.
-//
-// Key Roles:
-// - AbstractFactory: declares interfaces for each product type
-// - ConcreteFactory: implements creation for a product family
-// - AbstractProduct: declares product interfaces
-// - ConcreteProduct: product implementations that belong to a family
-//
-
-// ---------- Abstract Product ----------
-class Chair {
-public:
-    virtual std::string type() const = 0;
-    virtual ~Chair() = default;
-};
-
-// ---------- Concrete Products ----------
-class VictorianChair : public Chair {
-public:
-    std::string type() const override { return "Victorian Chair"; }
-};
-
-class ModernChair : public Chair {
-public:
-    std::string type() const override { return "Modern Chair"; }
-};
-
-// ---------- Abstract Factory Interface ----------
-class FurnitureFactory {
-public:
-    virtual Chair* createChair() const = 0;
-    virtual ~FurnitureFactory() = default;
-};
-
-// ---------- Concrete Factories ----------
-class VictorianFactory : public FurnitureFactory {
-public:
-    Chair* createChair() const override { return new VictorianChair(); }
-};
-
-class ModernFactory : public FurnitureFactory {
-public:
-    Chair* createChair() const override { return new ModernChair(); }
-};
-
-// ---------- Client Code ----------
-void showFurniture(const FurnitureFactory& factory) {
-    // Client only depends on abstract interfaces
-    std::unique_ptr<Chair> c(factory.createChair());
-    std::cout << "[Abstract Factory] Created: " << c->type() << "\n";
-}
-
-
-//
-// ===========================
-// Builder Pattern
+// Main: Demonstrate All Three Patterns
 // ===========================
-//
-// Intent: Separate the construction of a complex object from its representation
-// so the same construction process can create different representations.
-//
-// Key Roles:
-// - Product: complex object being built
-// - Builder: abstract interface defining build steps
-// - ConcreteBuilder: provides step-by-step implementation
-// - Director: controls construction sequence (optional)
-//
-
-class House {
-public:
-    void addPart(const std::string& part) { parts.push_back(part); }
-
-    void show() const {
-        std::cout << "[Builder] House with: ";
-        for (const auto& p : parts)
-            std::cout << p << " ";
-        std::cout << "\n";
-    }
-
-private:
-    std::vector<std::string> parts;
-};
-
-// ---------- Builder Interface ----------
-class HouseBuilder {
-public:
-    virtual void buildWalls() = 0;
-    virtual void buildDoors() = 0;
-    virtual void buildWindows() = 0;
-    virtual House* getResult() = 0;
-    virtual ~HouseBuilder() = default;
-};
-
-// ---------- Concrete Builder ----------
-class SimpleHouseBuilder : public HouseBuilder {
-    House* house;
-public:
-    SimpleHouseBuilder() { house = new House(); }
-    ~SimpleHouseBuilder() { delete house; }
-
-    void buildWalls() override { house->addPart("Walls"); }
-    void buildDoors() override { house->addPart("Doors"); }
-    void buildWindows() override { house->addPart("Windows"); }
-
-    House* getResult() override {
-        House* result = house;
-        house = new House(); // prepare for next build
-        return result;
-    }
-};
-
-// ---------- Director (optional) ----------
-class Director {
-    HouseBuilder* builder;
-public:
-    void setBuilder(HouseBuilder* b) { builder = b; }
-
-    // Build only essential parts
-    void buildMinimalHouse() {
-        builder->buildWalls();
-        builder->buildDoors();
-    }
 
-    // Build everything
-    void buildFullHouse() {
-        builder->buildWalls();
-        builder->buildDoors();
-        builder->buildWindows();
+int main(int argc, char* argv[]) {
+    // ==== Training Mode (PGO) ====
+    if (argc > 1 && std::string(argv[1]) == "--train") {
+        std::size_t rounds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+        auto start = std::chrono::steady_clock::now();
+        runTrainingWorkload(rounds);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "[Training] " << rounds << " rounds in " << elapsed.count() << " s\n";
+        return 0;
     }
-};
 
-
-//
-// ===========================
-// Main: Demonstrate All Three Patterns
-// ===========================
-
-int main() {
     // ==== Factory Method Demo ====
     RoadLogistics road;
     SeaLogistics sea;
@@ -231,5 +72,191 @@ int main() {
     std::unique_ptr<House> h2(builder.getResult());
     h2->show(); // House with Walls, Doors, Windows
 
+    // ==== Generic Factory Demo ====
+    TransportFactory transports;
+    transports.registerType<Truck>("road");
+    transports.registerType<Ship>("sea");
+    std::cout << "[Generic Factory] " << transports.create("sea")->deliver() << "\n";
+
+    ChairFactory chairs;
+    chairs.registerType<VictorianChair>("victorian");
+    chairs.registerType<ModernChair>("modern");
+    std::cout << "[Generic Factory] Created: " << chairs.create("modern")->type() << "\n";
+
+    // ==== Slot Map Demo ====
+    SlotMap<Truck> trucks;
+    SlotHandle first = createInto(trucks);
+    SlotHandle second = createInto(trucks);
+    trucks.erase(first);
+    std::cout << "[Slot Map] " << trucks.get(second)->deliver()
+              << ", stale handle " << (trucks.get(first) ? "resolved" : "rejected") << "\n";
+    trucks.compact();
+    std::cout << "[Slot Map] Fragmentation after compact: " << trucks.fragmentation() << "\n";
+
+    // ==== Compact Reference Demo ====
+    CompactArena<ModernChair> modernChairs;
+    CompactRef<ModernChair> chairRef = createChairInto(mf, modernChairs);
+    std::cout << "[Compact Ref] " << sizeof(chairRef) << "-byte reference to "
+              << chairRef.get(modernChairs)->type() << "\n";
+
+    CompactArena<House> houses;
+    director.buildFullHouse();
+    CompactRef<House> houseRef = storeHouse(houses, builder);
+    houses[houseRef].show();
+
+    // ==== Tagged Pointer Demo ====
+    Ship ship;
+    TaggedTransport tagged = TaggedTransport::make(&ship);
+    std::cout << "[Tagged Ptr] Is a Ship: " << (tagged.is<Ship>() ? "yes" : "no")
+              << ", " << deliverTagged(tagged) << "\n";
+
+    // ==== Batch Dispatch Demo ====
+    Truck truckA, truckB;
+    std::vector<const Transport*> fleet = { &truckA, &truckB, &ship };
+    std::vector<std::string> deliveries = deliverRuns(fleet);
+    std::cout << "[Batch] " << deliveries.size() << " deliveries, last: " << deliveries.back() << "\n";
+
+    // ==== Concurrent House Demo ====
+    ConcurrentHouse shared;
+    std::vector<std::thread> crews;
+    for (unsigned crew = 0; crew < 3; ++crew)
+        crews.emplace_back([&shared, crew] {
+            shared.addPart(crew, crew == 0 ? "Walls" : crew == 1 ? "Doors" : "Windows");
+        });
+    for (auto& t : crews)
+        t.join();
+    std::unique_ptr<House> h3(shared.finalize());
+    h3->show(); // Same order on every run
+
+    // ==== City Builder Demo ====
+    CityBuilder cityBuilder(8, 100);
+    std::unique_ptr<City> city(cityBuilder.build(4));
+    std::cout << "[City Builder] " << city->blockCount() << " blocks, "
+              << city->houseCount() << " houses\n";
+
+    // ==== Incremental Rebuild Demo ====
+    RecipeTracker tracker;
+    tracker.defineRecipe("cottage", { BuildStep::Walls, BuildStep::Doors });
+    std::size_t cottage = tracker.build("cottage");
+    std::size_t stepsRebuilt = tracker.updateRecipe("cottage", { BuildStep::Walls, BuildStep::Windows });
+    std::cout << "[Incremental] Rebuilt " << stepsRebuilt << " step(s)\n";
+    tracker.house(cottage).show(); // House with Walls, Windows
+
+    // ==== Fan-Out Builder Demo ====
+    SimpleHouseBuilder objectBuilder;
+    HouseTextBuilder textBuilder;
+    HouseStatsBuilder statsBuilder;
+    auto everything = fanOut(objectBuilder, textBuilder, statsBuilder);
+    director.setBuilder(&everything);
+    director.buildFullHouse();
+    std::unique_ptr<House> h4(everything.getResult());
+    h4->show();
+    std::cout << "[Fan-Out] Bytes: " << textBuilder.bytes()
+              << "[Fan-Out] Windows: " << statsBuilder.stats().back().windows << "\n";
+
+    // ==== Metrics Demo ====
+    // Removed when truckGauge goes out of scope, before `trucks` does
+    GaugeRegistration truckGauge = factoryMetrics().addGauge(
+        "truck_store_size", "Trucks held in the demo slot map.",
+        [&trucks] { return static_cast<double>(trucks.size()); });
+    std::ostringstream scrape;
+    writePrometheus(scrape);
+    std::cout << "[Metrics] Trucks created: " << factoryMetrics().trucksCreated.value()
+              << ", houses directed: " << factoryMetrics().housesDirected.value()
+              << ", scrape size: " << scrape.str().size() << " bytes\n";
+
+    // ==== Footprint and Pools Demo ====
+    writeFootprint(std::cout, {
+        footprintOf<Truck>("[Footprint] Truck", 1000000),
+        footprintOf<ModernChair>("[Footprint] ModernChair", 1000000),
+        footprintOf<House>("[Footprint] House", 1000000),
+    });
+    PooledTransportFactory pooledTransports;
+    pooledTransports.registerType<Ship>("sea");
+    std::cout << "[Pooled Factory] " << pooledTransports.create("sea")->deliver() << "\n";
+
+    // ==== Prewarming Demo ====
+    PrewarmConfig warm;
+    warm.transports = 1000;
+    warm.chairs = 1000;
+    warm.houses = 1000;
+    prewarmProducts(warm);
+    std::cout << "[Prewarm] Truck pool capacity: " << PoolFor<Truck>::instance().capacity() << "\n";
+
+    // ==== Idle Release Demo ====
+    IdleTrimmer trimmer(std::chrono::seconds(30));
+    trimmer.watchPool<Truck>(256);
+    trimmer.watchPool<House>(256);
+    std::size_t trimmedNow = trimmer.poll(IdleTrimmer::Clock::now() + std::chrono::minutes(1));
+    std::cout << "[Idle Release] Trimmed " << trimmedNow << " pools, Truck pool capacity now "
+              << PoolFor<Truck>::instance().capacity() << ", RSS down "
+              << trimmer.lastReleasedBytes() / 1024 << " KiB\n";
+
+    // ==== Speculative Pre-Creation Demo ====
+    ReadyBuffer<Transport, std::string> readyTransports(16);
+    readyTransports.registerType<Truck>("road");
+    readyTransports.registerType<Ship>("sea");
+    readyTransports.start();
+    SpeculativeLogistics speculativeRoad(readyTransports, "road");
+    speculativeRoad.planDelivery(); // Ready object if the filler got there first
+    readyTransports.stop();
+    std::cout << "[Speculative] Hits: " << readyTransports.hits()
+              << ", misses: " << readyTransports.misses() << "\n";
+
+    // ==== Zero-Copy Manifest Demo ====
+    OrderBuffer orders("order-1: 20 crates\norder-2: 3 pallets\n");
+    DeliveryManifest manifest = planBatch(sea, orders);
+    std::cout << "[Manifest] " << manifest.transport->deliver() << " carrying "
+              << manifest.orders.size() << " orders (" << manifest.payloadBytes()
+              << " bytes referenced, 0 copied)\n";
+
+    // ==== Trivial Products Demo ====
+    TrivialArena plainArena;
+    TrivialVector<PlainHouse> plainHouses;
+    PlainHouse* plain = plainArena.create<PlainHouse>();
+    plain->addPart(BuildStep::Walls);
+    plain->addPart(BuildStep::Windows);
+    plainHouses.push_back(*plain);
+    plainArena.reset(); // No destructors to run
+    plainHouses[0].show();
+
+    // ==== Speculative Build Demo ====
+    TrivialArena scratch;
+    ArenaHouseBuilder speculative(scratch);
+    director.setBuilder(&speculative);
+    for (const Recipe& variant : { Recipe{ BuildStep::Walls }, Recipe{ BuildStep::Walls, BuildStep::Doors } }) {
+        ArenaHouseBuilder::Checkpoint cp = speculative.checkpoint();
+        director.build(variant);
+        speculative.finishHouse();
+        if (speculative.houses().back()->partCount < 2)
+            speculative.rollback(cp); // Rejected: O(1) undo
+    }
+    std::cout << "[Speculative Build] Kept " << speculative.houses().size() << " of 2 variants\n";
+
+    // ==== Parallel Rendering Demo ====
+    std::string rendered = renderHouses(city->block(0), 4);
+    std::cout << "[Renderer] " << city->block(0).size() << " houses, "
+              << rendered.size() << " bytes; first line: "
+              << rendered.substr(0, rendered.find('\n') + 1);
+
+    // ==== JSON Output Demo ====
+    JsonWriter json;
+    writeJson(json, *h2);
+    planDeliveryJson(road, json);
+    showFurnitureJson(vf, json);
+    std::cout << "[JSON]\n" << json.str();
+
+    // ==== JSON-Lines Ingestion Demo ====
+    static const char orderLines[] =
+        "{\"id\":\"o-1\",\"mode\":\"road\",\"payload\":\"20 crates\"}\n"
+        "{\"id\":\"o-2\",\"mode\":\"sea\",\"payload\":\"3 pallets\",\"priority\":2}\n"
+        "{\"id\":\"o-3\",\"mode\":\"air\"}\n";
+    PayloadOwner orderLinesOwner; // Static text; owner only marks the lifetime
+    OrderBatches ingested = ingestOrders(orderLines, sizeof(orderLines) - 1, orderLinesOwner);
+    DeliveryManifest roadRun = planBatch(road, ingested.road);
+    DeliveryManifest seaRun = planBatch(sea, ingested.sea);
+    std::cout << "[Ingestion] " << roadRun.orders.size() << " by road, "
+              << seaRun.orders.size() << " by sea, " << ingested.rejected << " rejected\n";
+
     return 0;
 }
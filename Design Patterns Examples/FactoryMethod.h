@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GenericFactory.h"
+#include "Instrumentation.h"
+
+//
+// ===========================
+// Factory Method Pattern
+// ===========================
+//
+// Intent: Define an interface for creating an object, but let subclasses
+// decide which class to instantiate. Factory Method lets a class defer
+// instantiation to subclasses.
+//
+// Key Roles:
+// - Product: common interface for all possible products
+// - ConcreteProduct: specific classes implementing the product
+// - Creator: declares the factory method (can have default implementations)
+// - ConcreteCreator: overrides the factory method to return a ConcreteProduct
+//
+
+// ---------- Product Interface ----------
+class Transport {
+public:
+    virtual std::string deliver() const = 0;
+
+    // Batch entry point: every item must share the dynamic type of *this, so
+    // overrides can loop without a virtual call per item
+    virtual void deliverAll(const Transport* const* items, std::size_t count,
+                            std::vector<std::string>& out) const {
+        for (std::size_t i = 0; i < count; ++i)
+            out.push_back(items[i]->deliver());
+    }
+
+    virtual ~Transport() = default;
+};
+
+// ---------- Concrete Products ----------
+class Truck : public Transport {
+public:
+    std::string deliver() const override {
+        DP_PROBE1(deliver, "Truck");
+        return "Delivery by Truck";
+    }
+
+    void deliverAll(const Transport* const* items, std::size_t count,
+                    std::vector<std::string>& out) const override {
+        for (std::size_t i = 0; i < count; ++i)
+            out.push_back(static_cast<const Truck*>(items[i])->Truck::deliver());
+    }
+};
+
+class Ship : public Transport {
+public:
+    std::string deliver() const override {
+        DP_PROBE1(deliver, "Ship");
+        return "Delivery by Ship";
+    }
+
+    void deliverAll(const Transport* const* items, std::size_t count,
+                    std::vector<std::string>& out) const override {
+        for (std::size_t i = 0; i < count; ++i)
+            out.push_back(static_cast<const Ship*>(items[i])->Ship::deliver());
+    }
+};
+
+template <>
+struct CreationHook<Truck> {
+    static void created() {
+        DP_PROBE1(create_transport, "Truck");
+        factoryMetrics().trucksCreated.add();
+    }
+};
+
+template <>
+struct CreationHook<Ship> {
+    static void created() {
+        DP_PROBE1(create_transport, "Ship");
+        factoryMetrics().shipsCreated.add();
+    }
+};
+
+using TransportFactory = Factory<Transport, std::string>;
+
+// ---------- Creator Interface ----------
+class Logistics {
+public:
+    virtual Transport* createTransport() const = 0; // Factory Method
+    virtual ~Logistics() = default;
+
+    // Template method using the product created by factory method
+    void planDelivery() const {
+        LatencyTimer timer(factoryMetrics().planDeliveryLatency);
+        std::unique_ptr<Transport> t(createTransport()); // Decouples creation
+        std::cout << "[Factory Method] " << t->deliver() << "\n";
+    }
+};
+
+// ---------- Concrete Creators ----------
+// Heap-created products are released to the caller, who deletes them
+class RoadLogistics : public Logistics {
+public:
+    Transport* createTransport() const override {
+        return TransportFactory::make<Truck>().release();
+    }
+};
+
+class SeaLogistics : public Logistics {
+public:
+    Transport* createTransport() const override {
+        return TransportFactory::make<Ship>().release();
+    }
+};
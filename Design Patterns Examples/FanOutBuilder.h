@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Builder.h"
+
+//
+// ===========================
+// Fan-Out Builder
+// ===========================
+//
+// Intent: Produce several representations of a house in one Director pass by
+// forwarding every build step to a list of child builders.
+//
+// Key Roles:
+// - HouseTextBuilder / HouseStatsBuilder: extra representations (bytes,
+//   counts); step builders only, as they produce no House object
+// - FanOutBuilder: forwards to children chosen at run time (virtual calls)
+// - StaticFanOutBuilder: forwards to children fixed at compile time, calling
+//   each concrete builder directly so the forwarding can be inlined
+//
+// A fan-out builder has one primary HouseBuilder, whose House getResult()
+// returns, plus any number of step builders that are finished alongside it.
+//
+
+// ---------- Additional Representations ----------
+class HouseTextBuilder final : public HouseStepBuilder {
+public:
+    void buildWalls() override { addPart("Walls"); }
+    void buildDoors() override { addPart("Doors"); }
+    void buildWindows() override { addPart("Windows"); }
+
+    void finishHouse() override {
+        text += '\n'; // One line per house
+        partsInHouse = 0;
+    }
+
+    const std::string& bytes() const { return text; }
+
+private:
+    void addPart(const char* part) {
+        if (partsInHouse++ > 0)
+            text += ',';
+        text += part;
+    }
+
+    std::string text;
+    std::size_t partsInHouse = 0;
+};
+
+struct HouseStats {
+    unsigned walls = 0;
+    unsigned doors = 0;
+    unsigned windows = 0;
+};
+
+class HouseStatsBuilder final : public HouseStepBuilder {
+public:
+    void buildWalls() override { ++current.walls; }
+    void buildDoors() override { ++current.doors; }
+    void buildWindows() override { ++current.windows; }
+
+    void finishHouse() override {
+        finished.push_back(current);
+        current = HouseStats();
+    }
+
+    const std::vector<HouseStats>& stats() const { return finished; }
+
+private:
+    HouseStats current;
+    std::vector<HouseStats> finished;
+};
+
+// ---------- Run-Time Fan-Out ----------
+class FanOutBuilder : public HouseBuilder {
+public:
+    FanOutBuilder(HouseBuilder& primary, std::vector<HouseStepBuilder*> others)
+        : primary(primary), others(std::move(others)) {}
+
+    void buildWalls() override {
+        primary.buildWalls();
+        for (auto* b : others) b->buildWalls();
+    }
+    void buildDoors() override {
+        primary.buildDoors();
+        for (auto* b : others) b->buildDoors();
+    }
+    void buildWindows() override {
+        primary.buildWindows();
+        for (auto* b : others) b->buildWindows();
+    }
+
+    House* getResult() override {
+        for (auto* b : others)
+            b->finishHouse();
+        return primary.getResult();
+    }
+
+private:
+    HouseBuilder& primary;
+    std::vector<HouseStepBuilder*> others;
+};
+
+// ---------- Compile-Time Fan-Out ----------
+template <class Primary, class... Others>
+class StaticFanOutBuilder final : public HouseBuilder {
+public:
+    explicit StaticFanOutBuilder(Primary& primary, Others&... others) : children(primary, others...) {}
+
+    // Qualified calls name the concrete override, so none of them is virtual
+    void buildWalls() override {
+        forEach([](auto& b) { using B = std::decay_t<decltype(b)>; b.B::buildWalls(); });
+    }
+    void buildDoors() override {
+        forEach([](auto& b) { using B = std::decay_t<decltype(b)>; b.B::buildDoors(); });
+    }
+    void buildWindows() override {
+        forEach([](auto& b) { using B = std::decay_t<decltype(b)>; b.B::buildWindows(); });
+    }
+
+    House* getResult() override {
+        finishOthers(std::index_sequence_for<Others...>());
+        return std::get<0>(children).Primary::getResult();
+    }
+
+private:
+    template <class F>
+    void forEach(F f) { forEachIndex(f, std::index_sequence_for<Primary, Others...>()); }
+
+    template <class F, std::size_t... I>
+    void forEachIndex(F& f, std::index_sequence<I...>) {
+        using expand = int[];
+        (void)expand{ 0, (f(std::get<I>(children)), 0)... };
+    }
+
+    template <std::size_t... I>
+    void finishOthers(std::index_sequence<I...>) {
+        using expand = int[];
+        (void)expand{ 0, (std::get<I + 1>(children).Others::finishHouse(), 0)... };
+    }
+
+    std::tuple<Primary&, Others&...> children;
+};
+
+template <class Primary, class... Others>
+StaticFanOutBuilder<Primary, Others...> fanOut(Primary& primary, Others&... others) {
+    return StaticFanOutBuilder<Primary, Others...>(primary, others...);
+}
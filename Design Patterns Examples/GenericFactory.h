@@ -0,0 +1,115 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+//
+// ===========================
+// Generic Factory (policy-based)
+// ===========================
+//
+// Intent: Capture the creation, ownership and lookup logic that Logistics and
+// FurnitureFactory used to write by hand, once, for any product hierarchy.
+// Concrete products are created by type (make<Concrete>(), no lookup) or
+// registered under a key and created by key.
+//
+// Key Roles:
+// - Base: the product interface (Transport, Chair, ...)
+// - Key: whatever identifies a concrete product ("road", "modern", enum, ...)
+// - CreationPolicy: how products are allocated and who frees them
+// - ThreadingPolicy: whether registration/creation is guarded by a lock
+// - CreationHook: per-product probe and counters, fired by every path
+//
+// The concrete Logistics and FurnitureFactory creators are thin wrappers over
+// make<Concrete>(), so an allocation or instrumentation change made here
+// applies to both hierarchies and to every keyed or pooled factory.
+//
+
+// ---------- Creation Hook ----------
+// Specialized next to a concrete product to record its creation
+template <class Concrete>
+struct CreationHook {
+    static void created() {}
+};
+
+// ---------- Creation Policies ----------
+// A creation policy provides a Deleter type and
+//     template <class Base, class Concrete>
+//     static std::unique_ptr<Base, Deleter> create();
+struct HeapCreation {
+    struct Deleter {
+        template <class T>
+        void operator()(T* p) const { delete p; }
+    };
+
+    template <class Base, class Concrete>
+    static std::unique_ptr<Base, Deleter> create() {
+        return std::unique_ptr<Base, Deleter>(new Concrete());
+    }
+};
+
+// ---------- Threading Policies ----------
+// A threading policy is a base class exposing a nested Lock type that is
+// constructed from the policy object around every registry access.
+class SingleThreaded {
+public:
+    struct Lock {
+        explicit Lock(const SingleThreaded&) {}
+    };
+};
+
+class MutexLocked {
+public:
+    struct Lock {
+        explicit Lock(const MutexLocked& owner) : guard(owner.mutex) {}
+        std::lock_guard<std::mutex> guard;
+    };
+
+private:
+    mutable std::mutex mutex;
+};
+
+// ---------- Factory Template ----------
+template <class Base, class Key,
+          class CreationPolicy = HeapCreation,
+          class ThreadingPolicy = SingleThreaded>
+class Factory : private ThreadingPolicy {
+public:
+    using Pointer = std::unique_ptr<Base, typename CreationPolicy::Deleter>;
+
+    // Creation by type: no registry, no lock
+    template <class Concrete>
+    static Pointer make() {
+        CreationHook<Concrete>::created();
+        return CreationPolicy::template create<Base, Concrete>();
+    }
+
+    template <class Concrete>
+    void registerType(const Key& key) {
+        typename ThreadingPolicy::Lock lock(*this);
+        creators[key] = &Factory::template make<Concrete>;
+    }
+
+    bool isRegistered(const Key& key) const {
+        typename ThreadingPolicy::Lock lock(*this);
+        return creators.find(key) != creators.end();
+    }
+
+    Pointer create(const Key& key) const {
+        Creator creator;
+        {
+            typename ThreadingPolicy::Lock lock(*this);
+            auto it = creators.find(key);
+            if (it == creators.end())
+                throw std::out_of_range("Factory: no product registered for key");
+            creator = it->second;
+        }
+        return creator(); // Construct outside the lock
+    }
+
+private:
+    using Creator = Pointer (*)();
+    std::map<Key, Creator> creators;
+};
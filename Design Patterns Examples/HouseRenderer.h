@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Builder.h"
+
+//
+// ===========================
+// Parallel House Rendering
+// ===========================
+//
+// Intent: Produce the text of House::show() for millions of houses at once.
+// Every house's output length is computed first, a prefix sum turns lengths
+// into offsets, and then each thread writes its houses straight into their
+// place in one shared buffer. No locks, no per-house strings, no copies.
+//
+
+// Renders houses[i] for every i into one string, using `threads` threads
+template <class Houses>
+std::string renderHouses(const Houses& houses, unsigned threads = std::thread::hardware_concurrency()) {
+    const std::size_t count = houses.size();
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(std::max<std::size_t>(count, 1))));
+
+    // Runs body(first, last) over `threads` contiguous slices of the houses
+    auto parallel = [&](auto body) {
+        std::vector<std::thread> pool;
+        std::size_t slice = (count + threads - 1) / threads;
+        for (unsigned t = 1; t < threads; ++t)
+            pool.emplace_back(body, std::min(count, t * slice), std::min(count, (t + 1) * slice));
+        body(0, std::min(count, slice));
+        for (auto& thread : pool)
+            thread.join();
+    };
+
+    // 1. Lengths
+    std::vector<std::size_t> offsets(count + 1, 0);
+    parallel([&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i)
+            offsets[i + 1] = houses[i].describedLength();
+    });
+
+    // 2. Prefix sum: offsets[i] is where house i starts
+    for (std::size_t i = 0; i < count; ++i)
+        offsets[i + 1] += offsets[i];
+
+    // 3. Disjoint writes into the shared buffer
+    std::string out(offsets[count], '\0');
+    char* base = &out[0];
+    parallel([&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i)
+            houses[i].describeTo(base + offsets[i]);
+    });
+    return out;
+}
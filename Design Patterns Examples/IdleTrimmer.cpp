@@ -0,0 +1,63 @@
+#include "IdleTrimmer.h"
+
+#include <cstdio>
+#include <utility>
+
+#if defined(__linux__)
+#include <malloc.h>
+#include <unistd.h>
+#endif
+
+std::size_t residentSetBytes() {
+#if defined(__linux__)
+    std::FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (!statm)
+        return 0;
+    unsigned long totalPages = 0, residentPages = 0;
+    int fields = std::fscanf(statm, "%lu %lu", &totalPages, &residentPages);
+    std::fclose(statm);
+    return fields == 2 ? residentPages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+    return 0;
+#endif
+}
+
+void releaseFreeHeapPages() {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+void IdleTrimmer::watch(std::function<std::uint64_t()> activity, std::function<void()> trim) {
+    Target target;
+    target.activity = std::move(activity);
+    target.trim = std::move(trim);
+    target.lastActivity = target.activity();
+    target.lastChange = Clock::now();
+    targets.push_back(std::move(target));
+}
+
+std::size_t IdleTrimmer::poll(Clock::time_point now) {
+    std::size_t trimmed = 0;
+    std::size_t residentBefore = 0;
+    for (auto& target : targets) {
+        std::uint64_t activity = target.activity();
+        if (activity != target.lastActivity) {
+            target.lastActivity = activity;
+            target.lastChange = now;
+            target.trimmed = false; // Busy again: eligible for the next quiet period
+        } else if (!target.trimmed && now - target.lastChange >= idleAfter) {
+            if (trimmed == 0)
+                residentBefore = residentSetBytes();
+            target.trim();
+            target.trimmed = true;
+            ++trimmed;
+        }
+    }
+    if (trimmed > 0) {
+        releaseFreeHeapPages();
+        std::size_t residentAfter = residentSetBytes();
+        releasedBytes = residentBefore > residentAfter ? residentBefore - residentAfter : 0;
+    }
+    return trimmed;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "ProductPools.h"
+#include "SlotMap.h"
+#include "TrivialProducts.h"
+
+//
+// ===========================
+// Idle Memory Release
+// ===========================
+//
+// Intent: Give memory held by product pools, arenas and stores back during
+// quiet periods instead of holding peak-sized memory forever.
+//
+// IdleTrimmer watches an activity counter per pool, arena or store. A
+// watched target is trimmed once its counter has not moved for `idleAfter`,
+// keeping its `retain` low-water mark warm. After a trim it is left alone until activity
+// resumes and stops again, so a quiet process is not trimmed repeatedly and
+// a busy one is never trimmed mid-burst. Call poll() periodically, e.g. from
+// the service's housekeeping timer.
+//
+
+// Resident set size of this process in bytes, or 0 where unsupported
+std::size_t residentSetBytes();
+
+// Asks the system allocator to return free pages (glibc: madvise DONTNEED)
+void releaseFreeHeapPages();
+
+class IdleTrimmer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit IdleTrimmer(Clock::duration idleAfter) : idleAfter(idleAfter) {}
+
+    void watch(std::function<std::uint64_t()> activity, std::function<void()> trim);
+
+    // Types that share a size class share one pool: it is watched once,
+    // keeping the largest `retain` asked for
+    template <class T>
+    void watchPool(std::size_t retain) {
+        const void* pool = &PoolFor<T>::instance();
+        for (auto& target : targets)
+            if (target.pool == pool) {
+                retain = std::max(retain, target.retain);
+                target.retain = retain;
+                target.trim = [retain] { PoolFor<T>::instance().trim(retain); };
+                return;
+            }
+        watch([] { return PoolFor<T>::instance().activity(); },
+              [retain] { PoolFor<T>::instance().trim(retain); });
+        targets.back().pool = pool;
+        targets.back().retain = retain;
+    }
+
+    // TrivialArena is single-threaded: poll() from the thread that uses it,
+    // and keep the arena alive as long as the trimmer
+    void watchArena(TrivialArena& arena, std::size_t retainChunks) {
+        watch([&arena] { return arena.activity(); },
+              [&arena, retainChunks] { arena.trim(retainChunks); });
+    }
+
+    // Compacts the store once it goes idle. Same threading and lifetime
+    // rules as watchArena().
+    template <class T>
+    void watchStore(SlotMap<T>& store) {
+        watch([&store] { return store.activity(); }, [&store] { store.compact(); });
+    }
+
+    // Returns the number of targets trimmed by this call. Free heap pages are
+    // returned to the system once, after all of them.
+    std::size_t poll(Clock::time_point now = Clock::now());
+
+    // Drop in resident set size across the last poll() that trimmed
+    std::size_t lastReleasedBytes() const { return releasedBytes; }
+
+private:
+    struct Target {
+        std::function<std::uint64_t()> activity;
+        std::function<void()> trim;
+        std::uint64_t lastActivity = 0;
+        Clock::time_point lastChange;
+        bool trimmed = false;
+        const void* pool = nullptr; // Set for watchPool() targets
+        std::size_t retain = 0;
+    };
+
+    Clock::duration idleAfter;
+    std::vector<Target> targets;
+    std::size_t releasedBytes = 0;
+};
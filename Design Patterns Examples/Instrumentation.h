@@ -0,0 +1,270 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//
+// Static tracepoints (USDT). Each probe compiles to a single nop plus an ELF
+// note in .note.stapsdt, and only costs anything while bpftrace or perf is
+// attached. All probes live under the "design_patterns" provider.
+//
+// - With <sys/sdt.h> (systemtap-sdt-dev) its DTRACE_PROBE1 is used.
+// - Without it, on x86-64 and AArch64 ELF targets, the same note (stapsdt
+//   version 3, one 8-byte unsigned argument) is emitted directly below.
+// - Elsewhere, or when built with DP_DISABLE_PROBES, probes compile away.
+//
+#if !defined(DP_DISABLE_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define DP_HAVE_SDT 1
+#endif
+#endif
+
+#if defined(DP_DISABLE_PROBES)
+#define DP_PROBE1(name, arg) ((void)0)
+#elif defined(DP_HAVE_SDT)
+#define DP_PROBE1(name, arg) DTRACE_PROBE1(design_patterns, name, arg)
+#elif defined(__ELF__) && (defined(__x86_64__) || defined(__aarch64__)) && (defined(__GNUC__) || defined(__clang__))
+#include <type_traits>
+
+// Probe arguments are passed as one unsigned 64-bit value: the address for
+// pointers (string labels), the value for integers
+inline std::uint64_t dpProbeArg(const void* p) { return reinterpret_cast<std::uintptr_t>(p); }
+
+template <class T, class = typename std::enable_if<std::is_integral<T>::value>::type>
+inline std::uint64_t dpProbeArg(T v) { return static_cast<std::uint64_t>(v); }
+
+#define DP_PROBE1(name, arg)                                                     \
+    do {                                                                         \
+        std::uint64_t dpProbeValue = dpProbeArg(arg);                            \
+        __asm__ __volatile__(                                                    \
+            "990: nop\n"                                                         \
+            ".pushsection .note.stapsdt,\"?\",\"note\"\n"                          \
+            ".balign 4\n"                                                        \
+            ".4byte 992f-991f, 994f-993f, 3\n"                                   \
+            "991: .asciz \"stapsdt\"\n"                                          \
+            "992: .balign 4\n"                                                   \
+            "993: .8byte 990b\n"                                                 \
+            ".8byte _.stapsdt.base\n"                                            \
+            ".8byte 0\n"                                                         \
+            ".asciz \"design_patterns\"\n"                                       \
+            ".asciz \"" #name "\"\n"                                              \
+            ".asciz \"8@%[value]\"\n"                                            \
+            "994: .balign 4\n"                                                   \
+            ".popsection\n"                                                      \
+            ".ifndef _.stapsdt.base\n"                                           \
+            ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n" \
+            ".weak _.stapsdt.base\n"                                             \
+            ".hidden _.stapsdt.base\n"                                           \
+            "_.stapsdt.base: .space 1\n"                                         \
+            ".size _.stapsdt.base, 1\n"                                          \
+            ".popsection\n"                                                      \
+            ".endif\n"                                                           \
+            :                                                                    \
+            : [value] "nor"(dpProbeValue));                                      \
+    } while (0)
+#else
+#define DP_PROBE1(name, arg) ((void)0)
+#endif
+
+//
+// ===========================
+// Factory Metrics
+// ===========================
+//
+// Counters and latency histograms updated by the creational code. Each
+// metric is split into per-thread-ish shards on separate cache lines, so an
+// update is one uncontended relaxed add; shards are only summed when the
+// metrics are scraped (see MetricsExport.h).
+//
+
+// ---------- Sharded Counter ----------
+class ShardedCounter {
+public:
+    static const std::size_t shardCount = 16;
+
+    void add(std::uint64_t n = 1) {
+        shards[shardIndex()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    std::uint64_t value() const {
+        std::uint64_t total = 0;
+        for (const auto& shard : shards)
+            total += shard.value.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value{ 0 };
+    };
+
+    static std::size_t shardIndex() {
+        static std::atomic<std::size_t> nextThread{ 0 };
+        thread_local std::size_t index = nextThread.fetch_add(1) % shardCount;
+        return index;
+    }
+
+    Shard shards[shardCount];
+};
+
+// ---------- Latency Histogram ----------
+class LatencyHistogram {
+public:
+    static const std::size_t bucketCount = 8;
+
+    // Upper bounds in nanoseconds; a final +Inf bucket is implied
+    static std::uint64_t bound(std::size_t i) {
+        static const std::uint64_t bounds[bucketCount] = {
+            1000, 5000, 10000, 50000, 100000, 500000, 1000000, 10000000
+        };
+        return bounds[i];
+    }
+
+    void record(std::uint64_t nanoseconds) {
+        std::size_t i = 0;
+        while (i < bucketCount && nanoseconds > bound(i))
+            ++i;
+        buckets[i].add();
+        totalNanoseconds.add(nanoseconds);
+    }
+
+    std::uint64_t bucket(std::size_t i) const { return buckets[i].value(); }
+    std::uint64_t sumNanoseconds() const { return totalNanoseconds.value(); }
+
+private:
+    ShardedCounter buckets[bucketCount + 1];
+    ShardedCounter totalNanoseconds;
+};
+
+// Records the lifetime of the scope into a histogram
+class LatencyTimer {
+public:
+    explicit LatencyTimer(LatencyHistogram& histogram)
+        : histogram(histogram), start(std::chrono::steady_clock::now()) {}
+
+    ~LatencyTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        histogram.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+private:
+    LatencyHistogram& histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+// ---------- Registry ----------
+struct FactoryMetrics;
+
+// Keeps a gauge registered for as long as it lives; destroying it removes
+// the gauge, after which its read function is never called again
+class GaugeRegistration {
+public:
+    GaugeRegistration() = default;
+    GaugeRegistration(FactoryMetrics* owner, std::uint64_t id) : owner(owner), id(id) {}
+    ~GaugeRegistration() { reset(); }
+
+    GaugeRegistration(GaugeRegistration&& other) noexcept : owner(other.owner), id(other.id) {
+        other.owner = nullptr;
+    }
+    GaugeRegistration& operator=(GaugeRegistration&& other) noexcept {
+        if (this != &other) {
+            reset();
+            owner = other.owner;
+            id = other.id;
+            other.owner = nullptr;
+        }
+        return *this;
+    }
+
+    GaugeRegistration(const GaugeRegistration&) = delete;
+    GaugeRegistration& operator=(const GaugeRegistration&) = delete;
+
+    inline void reset();
+
+private:
+    FactoryMetrics* owner = nullptr;
+    std::uint64_t id = 0;
+};
+
+struct FactoryMetrics {
+    ShardedCounter trucksCreated;
+    ShardedCounter shipsCreated;
+    ShardedCounter victorianChairsCreated;
+    ShardedCounter modernChairsCreated;
+    ShardedCounter housesDirected;
+
+    LatencyHistogram planDeliveryLatency;
+    LatencyHistogram showFurnitureLatency;
+    LatencyHistogram directorLatency;
+
+    // Occupancy of pools, arenas and stores, sampled only when scraped.
+    // Gauges sharing a name form one metric, told apart by their labels,
+    // e.g. {block_bytes="16"}.
+    struct GaugeReading {
+        std::string name;
+        std::string labels;
+        std::string help;
+        double value;
+    };
+
+    // `read` runs under the registry lock during a scrape; keep the returned
+    // registration alive no longer than what `read` refers to
+    GaugeRegistration addGauge(const std::string& name, const std::string& help,
+                               std::function<double()> read, const std::string& labels = std::string()) {
+        std::lock_guard<std::mutex> lock(gaugeMutex);
+        std::uint64_t id = ++lastGaugeId;
+        gauges.push_back(Gauge{ id, name, labels, help, std::move(read) });
+        return GaugeRegistration(this, id);
+    }
+
+    void removeGauge(std::uint64_t id) {
+        std::lock_guard<std::mutex> lock(gaugeMutex);
+        for (std::size_t i = 0; i < gauges.size(); ++i)
+            if (gauges[i].id == id) {
+                gauges.erase(gauges.begin() + i);
+                return;
+            }
+    }
+
+    // Values read under the lock, so no read races a removal
+    std::vector<GaugeReading> readGauges() const {
+        std::lock_guard<std::mutex> lock(gaugeMutex);
+        std::vector<GaugeReading> readings;
+        readings.reserve(gauges.size());
+        for (const auto& g : gauges)
+            readings.push_back(GaugeReading{ g.name, g.labels, g.help, g.read() });
+        return readings;
+    }
+
+private:
+    struct Gauge {
+        std::uint64_t id;
+        std::string name;
+        std::string labels;
+        std::string help;
+        std::function<double()> read;
+    };
+
+    mutable std::mutex gaugeMutex;
+    std::vector<Gauge> gauges;
+    std::uint64_t lastGaugeId = 0;
+};
+
+inline void GaugeRegistration::reset() {
+    if (owner)
+        owner->removeGauge(id);
+    owner = nullptr;
+}
+
+inline FactoryMetrics& factoryMetrics() {
+    static FactoryMetrics metrics;
+    return metrics;
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "AbstractFactory.h"
+#include "Builder.h"
+#include "FactoryMethod.h"
+#include "TrivialProducts.h"
+
+//
+// ===========================
+// Streaming JSON Output
+// ===========================
+//
+// Intent: Emit houses, deliveries and chairs as JSON lines straight into one
+// reusable buffer - no iostreams, no intermediate strings per value. Call
+// clear() between batches; the buffer keeps its capacity.
+//
+// Key Roles:
+// - JsonWriter: appends tokens and handles commas and string escaping
+// - writeJson overloads: one record per product, terminated by a newline
+// - planDeliveryJson / showFurnitureJson: JSON forms of the demo clients
+//
+
+class JsonWriter {
+public:
+    static const std::size_t maxDepth = 32;
+
+    void beginObject() { open('{'); }
+    void endObject() { close('}'); }
+    void beginArray() { open('['); }
+    void endArray() { close(']'); }
+
+    void key(const char* name, std::size_t length) {
+        value(name, length);
+        buffer += ':';
+        afterKey = true;
+    }
+    void key(const char* name) { key(name, std::strlen(name)); }
+
+    void value(const char* text, std::size_t length) {
+        separate();
+        buffer += '"';
+        escape(text, length);
+        buffer += '"';
+    }
+    void value(const char* text) { value(text, std::strlen(text)); }
+    void value(const std::string& text) { value(text.data(), text.size()); }
+
+    void value(unsigned long long number) {
+        separate();
+        char digits[20];
+        std::size_t n = 0;
+        do {
+            digits[n++] = static_cast<char>('0' + number % 10);
+            number /= 10;
+        } while (number);
+        while (n)
+            buffer += digits[--n];
+    }
+
+    // Ends one JSON-lines record
+    void endRecord() { buffer += '\n'; }
+
+    void clear() {
+        buffer.clear();
+        depth = 0;
+        afterKey = false;
+    }
+
+    const std::string& str() const { return buffer; }
+    void reserve(std::size_t bytes) { buffer.reserve(bytes); }
+
+private:
+    void open(char bracket) {
+        separate();
+        if (depth == maxDepth)
+            throw std::length_error("JsonWriter: nesting too deep");
+        buffer += bracket;
+        first[depth++] = true;
+    }
+
+    void close(char bracket) {
+        --depth;
+        buffer += bracket;
+    }
+
+    // Comma before every value except the first in its container or after a key
+    void separate() {
+        if (afterKey) {
+            afterKey = false;
+            return;
+        }
+        if (depth > 0) {
+            if (!first[depth - 1])
+                buffer += ',';
+            first[depth - 1] = false;
+        }
+    }
+
+    void escape(const char* text, std::size_t length) {
+        static const char hex[] = "0123456789abcdef";
+        std::size_t plain = 0; // Start of the run that needs no escaping
+        for (std::size_t i = 0; i < length; ++i) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\')
+                continue;
+            buffer.append(text + plain, i - plain);
+            plain = i + 1;
+            buffer += '\\';
+            switch (c) {
+            case '"': buffer += '"'; break;
+            case '\\': buffer += '\\'; break;
+            case '\n': buffer += 'n'; break;
+            case '\r': buffer += 'r'; break;
+            case '\t': buffer += 't'; break;
+            default:
+                buffer += "u00";
+                buffer += hex[c >> 4];
+                buffer += hex[c & 0xF];
+            }
+        }
+        buffer.append(text + plain, length - plain);
+    }
+
+    std::string buffer;
+    bool first[maxDepth];
+    std::size_t depth = 0;
+    bool afterKey = false;
+};
+
+// ---------- Product Records ----------
+inline void writeJson(JsonWriter& json, const House& house) {
+    json.beginObject();
+    json.key("parts");
+    json.beginArray();
+    for (const auto& part : house.getParts())
+        json.value(part);
+    json.endArray();
+    json.endObject();
+    json.endRecord();
+}
+
+inline void writeJson(JsonWriter& json, const PlainHouse& house) {
+    static const char* const names[] = { "Walls", "Doors", "Windows" };
+    json.beginObject();
+    json.key("parts");
+    json.beginArray();
+    for (std::size_t i = 0; i < house.partCount; ++i)
+        json.value(names[static_cast<int>(house.parts[i])]);
+    json.endArray();
+    json.endObject();
+    json.endRecord();
+}
+
+inline void writeJson(JsonWriter& json, const Transport& transport) {
+    json.beginObject();
+    json.key("delivery");
+    json.value(transport.deliver()); // The virtual interface returns a string
+    json.endObject();
+    json.endRecord();
+}
+
+inline void writeJson(JsonWriter& json, const PlainTransport& transport) {
+    json.beginObject();
+    json.key("delivery");
+    json.value(transport.deliver());
+    json.endObject();
+    json.endRecord();
+}
+
+inline void writeJson(JsonWriter& json, const Chair& chair) {
+    json.beginObject();
+    json.key("chair");
+    json.value(chair.type());
+    json.endObject();
+    json.endRecord();
+}
+
+inline void writeJson(JsonWriter& json, const PlainChair& chair) {
+    json.beginObject();
+    json.key("chair");
+    json.value(chair.type());
+    json.endObject();
+    json.endRecord();
+}
+
+// ---------- Client Code ----------
+inline void planDeliveryJson(const Logistics& logistics, JsonWriter& json) {
+    std::unique_ptr<Transport> t(logistics.createTransport());
+    writeJson(json, *t);
+}
+
+inline void showFurnitureJson(const FurnitureFactory& factory, JsonWriter& json) {
+    std::unique_ptr<Chair> c(factory.createChair());
+    writeJson(json, *c);
+}
@@ -0,0 +1,161 @@
+#include "MetricsExport.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+// ---------- Prometheus Text Format ----------
+static void writeCounter(std::ostream& out, const char* name, const char* help,
+                         const char* labels, std::uint64_t value, bool header) {
+    if (header) {
+        out << "# HELP " << name << ' ' << help << '\n';
+        out << "# TYPE " << name << " counter\n";
+    }
+    out << name << labels << ' ' << value << '\n';
+}
+
+static void writeHistogram(std::ostream& out, const char* name, const char* help,
+                           const LatencyHistogram& h) {
+    out << "# HELP " << name << ' ' << help << '\n';
+    out << "# TYPE " << name << " histogram\n";
+    std::uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < LatencyHistogram::bucketCount; ++i) {
+        cumulative += h.bucket(i);
+        out << name << "_bucket{le=\"" << LatencyHistogram::bound(i) / 1e9 << "\"} " << cumulative << '\n';
+    }
+    cumulative += h.bucket(LatencyHistogram::bucketCount);
+    out << name << "_bucket{le=\"+Inf\"} " << cumulative << '\n';
+    out << name << "_sum " << h.sumNanoseconds() / 1e9 << '\n';
+    out << name << "_count " << cumulative << '\n';
+}
+
+void writePrometheus(std::ostream& out, const FactoryMetrics& m) {
+    writeCounter(out, "transports_created_total", "Transports created by Logistics.",
+                 "{type=\"truck\"}", m.trucksCreated.value(), true);
+    writeCounter(out, "transports_created_total", "", "{type=\"ship\"}", m.shipsCreated.value(), false);
+    writeCounter(out, "chairs_created_total", "Chairs created by FurnitureFactory.",
+                 "{style=\"victorian\"}", m.victorianChairsCreated.value(), true);
+    writeCounter(out, "chairs_created_total", "", "{style=\"modern\"}", m.modernChairsCreated.value(), false);
+    writeCounter(out, "houses_directed_total", "Houses built through Director.", "",
+                 m.housesDirected.value(), true);
+
+    writeHistogram(out, "plan_delivery_seconds", "Latency of Logistics::planDelivery().",
+                   m.planDeliveryLatency);
+    writeHistogram(out, "show_furniture_seconds", "Latency of showFurniture().",
+                   m.showFurnitureLatency);
+    writeHistogram(out, "director_build_seconds", "Latency of one Director recipe.",
+                   m.directorLatency);
+
+    // One HELP/TYPE header per metric name, however many label sets it has
+    std::vector<FactoryMetrics::GaugeReading> gauges = m.readGauges();
+    std::stable_sort(gauges.begin(), gauges.end(),
+                     [](const FactoryMetrics::GaugeReading& a, const FactoryMetrics::GaugeReading& b) {
+                         return a.name < b.name;
+                     });
+    for (std::size_t i = 0; i < gauges.size(); ++i) {
+        const auto& gauge = gauges[i];
+        if (i == 0 || gauges[i - 1].name != gauge.name) {
+            out << "# HELP " << gauge.name << ' ' << gauge.help << '\n';
+            out << "# TYPE " << gauge.name << " gauge\n";
+        }
+        out << gauge.name << gauge.labels << ' ' << gauge.value << '\n';
+    }
+}
+
+// ---------- Loopback HTTP Listener (POSIX) ----------
+#if defined(__unix__) || defined(__APPLE__)
+
+#ifdef MSG_NOSIGNAL
+static const int sendFlags = MSG_NOSIGNAL; // A client hanging up must not raise SIGPIPE
+#else
+static const int sendFlags = 0;
+#endif
+
+MetricsServer::MetricsServer(unsigned short port) {
+    listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0)
+        throw std::runtime_error("MetricsServer: socket() failed");
+    int reuse = 1;
+    ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // Local scrapes only
+    address.sin_port = htons(port);
+    socklen_t length = sizeof(address);
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+        || ::listen(listener, 16) < 0
+        || ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) < 0) {
+        ::close(listener);
+        throw std::runtime_error("MetricsServer: cannot listen on loopback port");
+    }
+    boundPort = ntohs(address.sin_port);
+    worker = std::thread([this] { serve(); });
+}
+
+MetricsServer::~MetricsServer() {
+    running.store(false);
+    ::shutdown(listener, SHUT_RDWR); // Wakes the blocked accept()
+    worker.join();
+    ::close(listener);
+}
+
+void MetricsServer::serve() {
+    int backoffMs = 0;
+    while (running.load()) {
+        int client = ::accept(listener, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            // Persistent failures (EMFILE, ENOBUFS, ...) would otherwise spin
+            backoffMs = backoffMs ? std::min(backoffMs * 2, 200) : 1;
+            std::this_thread::sleep_for(std::chrono::milliseconds(backoffMs));
+            continue;
+        }
+        backoffMs = 0;
+
+        timeval timeout;
+        timeout.tv_sec = clientTimeoutMs / 1000;
+        timeout.tv_usec = (clientTimeoutMs % 1000) * 1000;
+        ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        char request[1024];
+        (void)::recv(client, request, sizeof(request), 0); // Any path gets the metrics
+
+        std::ostringstream body;
+        writePrometheus(body);
+        std::string text = body.str();
+        std::ostringstream response;
+        response << "HTTP/1.0 200 OK\r\n"
+                 << "Content-Type: text/plain; version=0.0.4\r\n"
+                 << "Content-Length: " << text.size() << "\r\n\r\n"
+                 << text;
+        std::string bytes = response.str();
+        std::size_t sent = 0;
+        while (sent < bytes.size()) {
+            ssize_t n = ::send(client, bytes.data() + sent, bytes.size() - sent, sendFlags);
+            if (n <= 0)
+                break;
+            sent += static_cast<std::size_t>(n);
+        }
+        ::close(client);
+    }
+}
+
+#endif // __unix__ || __APPLE__
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <ostream>
+#include <thread>
+
+#include "Instrumentation.h"
+
+//
+// ===========================
+// Metrics Export
+// ===========================
+//
+// Intent: Expose FactoryMetrics to a Prometheus scraper. The text exposition
+// format is rendered on demand, and MetricsServer answers every HTTP request
+// on a loopback port with it. Shards are summed here, never on the hot path.
+//
+
+// ---------- Prometheus Text Format ----------
+void writePrometheus(std::ostream& out, const FactoryMetrics& m = factoryMetrics());
+
+// ---------- Loopback HTTP Listener (POSIX) ----------
+#if defined(__unix__) || defined(__APPLE__)
+
+// Serves one client at a time; a client that stops sending or reading is
+// dropped after clientTimeoutMs, so it cannot stall later scrapes or the
+// destructor for longer than that.
+class MetricsServer {
+public:
+    static const int clientTimeoutMs = 2000;
+
+    // Port 0 picks a free port; see port(). Throws std::runtime_error if the
+    // loopback port cannot be bound.
+    explicit MetricsServer(unsigned short port = 9464);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    unsigned short port() const { return boundPort; }
+
+private:
+    void serve();
+
+    int listener = -1;
+    unsigned short boundPort = 0;
+    std::atomic<bool> running{ true };
+    std::thread worker;
+};
+
+#endif // __unix__ || __APPLE__
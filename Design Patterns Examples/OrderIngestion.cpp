@@ -0,0 +1,196 @@
+#include "OrderIngestion.h"
+
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DP_HAVE_MMAP 1
+#endif
+
+// ---------- Memory-Mapped Input ----------
+MappedFile::MappedFile(const std::string& path) {
+#ifdef DP_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("MappedFile: cannot open " + path);
+    struct stat info;
+    if (::fstat(fd, &info) < 0) {
+        ::close(fd);
+        throw std::runtime_error("MappedFile: cannot stat " + path);
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    if (length > 0) {
+        void* view = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("MappedFile: cannot map " + path);
+        }
+        ::madvise(view, length, MADV_SEQUENTIAL); // One front-to-back pass
+        bytes = static_cast<const char*>(view);
+        mapped = true;
+    }
+    ::close(fd); // The mapping stays valid
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        throw std::runtime_error("MappedFile: cannot open " + path);
+    fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    bytes = fallback.data();
+    length = fallback.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef DP_HAVE_MMAP
+    if (mapped)
+        ::munmap(const_cast<char*>(bytes), length);
+#endif
+}
+
+// ---------- Parsing ----------
+static const char* skipSpace(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+        ++p;
+    return p;
+}
+
+// p points at the opening quote; returns one past the closing quote or null
+static const char* scanString(const char* p, const char* end, const char*& first, const char*& last) {
+    first = ++p;
+    while (true) {
+        p = findEither(p, end, '"', '\\');
+        if (p == end)
+            return nullptr;
+        if (*p == '"')
+            break;
+        if (end - p < 2) // Backslash with nothing to escape
+            return nullptr;
+        p += 2; // Skip the escaped character
+    }
+    last = p;
+    return p + 1;
+}
+
+static bool equals(const char* first, const char* last, const char* literal) {
+    std::size_t n = std::strlen(literal);
+    return static_cast<std::size_t>(last - first) == n && std::memcmp(first, literal, n) == 0;
+}
+
+static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+static const char* skipDigits(const char* p, const char* end) {
+    while (p < end && isDigit(*p))
+        ++p;
+    return p;
+}
+
+// A JSON number or true/false/null; returns one past it or null
+static const char* scanScalar(const char* p, const char* end) {
+    for (const char* literal : { "true", "false", "null" }) {
+        std::size_t n = std::strlen(literal);
+        if (static_cast<std::size_t>(end - p) >= n && std::memcmp(p, literal, n) == 0)
+            return p + n;
+    }
+    if (p < end && *p == '-')
+        ++p;
+    if (p == end || !isDigit(*p))
+        return nullptr;
+    p = *p == '0' ? p + 1 : skipDigits(p, end); // No leading zeros
+    if (p < end && *p == '.') {
+        if (++p == end || !isDigit(*p))
+            return nullptr;
+        p = skipDigits(p, end);
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        if (++p < end && (*p == '+' || *p == '-'))
+            ++p;
+        if (p == end || !isDigit(*p))
+            return nullptr;
+        p = skipDigits(p, end);
+    }
+    return p;
+}
+
+bool parseOrder(const char* begin, const char* end, const PayloadOwner& owner, Order& order) {
+    order = Order();
+    order.line = PayloadView(begin, static_cast<std::size_t>(end - begin), owner);
+
+    const char* p = skipSpace(begin, end);
+    if (p == end || *p++ != '{')
+        return false;
+    p = skipSpace(p, end);
+    bool empty = p < end && *p == '}';
+    while (!empty) {
+        p = skipSpace(p, end);
+        if (p == end || *p != '"') // Also rejects an empty member after ','
+            return false;
+        const char *keyFirst, *keyLast;
+        if (!(p = scanString(p, end, keyFirst, keyLast)))
+            return false;
+        p = skipSpace(p, end);
+        if (p == end || *p++ != ':')
+            return false;
+        p = skipSpace(p, end);
+        if (p == end)
+            return false;
+
+        if (*p == '"') {
+            const char *valueFirst, *valueLast;
+            if (!(p = scanString(p, end, valueFirst, valueLast)))
+                return false;
+            PayloadView value(valueFirst, static_cast<std::size_t>(valueLast - valueFirst), owner);
+            if (equals(keyFirst, keyLast, "id"))
+                order.id = value;
+            else if (equals(keyFirst, keyLast, "payload"))
+                order.payload = value;
+            else if (equals(keyFirst, keyLast, "mode"))
+                order.mode = equals(valueFirst, valueLast, "road") ? OrderMode::Road
+                    : equals(valueFirst, valueLast, "sea") ? OrderMode::Sea : OrderMode::Unknown;
+        } else if (*p == '{' || *p == '[') {
+            return false; // Orders are flat
+        } else if (!(p = scanScalar(p, end))) {
+            return false;
+        }
+
+        p = skipSpace(p, end);
+        if (p < end && *p == ',') {
+            ++p;
+            continue;
+        }
+        if (p < end && *p == '}')
+            break;
+        return false;
+    }
+    if (skipSpace(p + 1, end) != end) // Only whitespace may follow the object
+        return false;
+    return order.mode != OrderMode::Unknown;
+}
+
+OrderBatches ingestOrders(const char* data, std::size_t size, const PayloadOwner& owner) {
+    OrderBatches batches;
+    batches.bytes = size;
+    const char* end = data + size;
+    Order order;
+    for (const char* line = data; line < end;) {
+        const char* lineEnd = findByte(line, end, '\n');
+        if (lineEnd > line) {
+            if (!parseOrder(line, lineEnd, owner, order))
+                ++batches.rejected;
+            else if (order.mode == OrderMode::Road)
+                batches.road.push_back(order.line);
+            else
+                batches.sea.push_back(order.line);
+        }
+        if (lineEnd == end)
+            break;
+        line = lineEnd + 1;
+    }
+    return batches;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DP_HAVE_SSE2 1
+#endif
+
+#include "DeliveryManifest.h"
+#include "FactoryMethod.h"
+
+//
+// ===========================
+// JSON-Lines Order Ingestion
+// ===========================
+//
+// Intent: Turn a large JSON-lines file of orders into Road and Sea delivery
+// batches without copying or allocating per field. The file is memory mapped,
+// line ends and the quote/backslash that close string bodies are found 16
+// bytes at a time with SSE2 where available (the short structure between
+// strings is walked byte by byte), and every parsed field is a PayloadView
+// into the mapping.
+//
+// Expected line format (other string/number/literal fields are validated,
+// then skipped):
+//     {"id":"o-17","mode":"sea","payload":"20 crates"}
+// A line is rejected unless it is one flat object with nothing but
+// whitespace after it. String views are raw: escape sequences are kept as
+// they appear in the file.
+//
+
+// ---------- Memory-Mapped Input ----------
+class MappedFile : public PayloadOwner {
+public:
+    // Throws std::runtime_error if the file cannot be opened or mapped
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+private:
+    const char* bytes = nullptr;
+    std::size_t length = 0;
+    bool mapped = false;
+    std::string fallback; // Platforms without mmap read the file instead
+};
+
+// ---------- Structural Scanning ----------
+// First position in [p, end) holding a or b, or end
+inline const char* findEither(const char* p, const char* end, char a, char b) {
+#ifdef DP_HAVE_SSE2
+    const __m128i va = _mm_set1_epi8(a), vb = _mm_set1_epi8(b);
+    for (; end - p >= 16; p += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int hits = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, va), _mm_cmpeq_epi8(block, vb)));
+        if (hits) {
+            int bit = 0;
+            while (!(hits & (1 << bit)))
+                ++bit;
+            return p + bit;
+        }
+    }
+#endif
+    for (; p < end; ++p)
+        if (*p == a || *p == b)
+            return p;
+    return end;
+}
+
+inline const char* findByte(const char* p, const char* end, char c) {
+    const void* hit = std::memchr(p, c, static_cast<std::size_t>(end - p)); // Vectorized by the C library
+    return hit ? static_cast<const char*>(hit) : end;
+}
+
+// ---------- Orders ----------
+enum class OrderMode { Unknown, Road, Sea };
+
+struct Order {
+    PayloadView line;
+    PayloadView id;
+    PayloadView payload;
+    OrderMode mode = OrderMode::Unknown;
+};
+
+// Parses one line in place; returns false for lines it cannot read
+bool parseOrder(const char* begin, const char* end, const PayloadOwner& owner, Order& order);
+
+// ---------- Batches ----------
+struct OrderBatches {
+    std::vector<PayloadView> road; // Whole order lines, referenced in place
+    std::vector<PayloadView> sea;
+    std::size_t rejected = 0;
+    std::size_t bytes = 0;
+
+    std::size_t orders() const { return road.size() + sea.size(); }
+};
+
+OrderBatches ingestOrders(const char* data, std::size_t size, const PayloadOwner& owner);
+
+inline OrderBatches ingestOrders(const MappedFile& file) {
+    return ingestOrders(file.data(), file.size(), file);
+}
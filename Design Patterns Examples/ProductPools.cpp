@@ -0,0 +1,80 @@
+#include "ProductPools.h"
+
+#include <map>
+
+#if defined(__linux__) || defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+// ---------- Allocator Introspection ----------
+std::size_t allocatedBlockSize(void* p, std::size_t requested) {
+    (void)requested;
+#if defined(__GLIBC__)
+    return malloc_usable_size(p) + sizeof(std::size_t); // Plus the chunk header
+#elif defined(_MSC_VER)
+    return _msize(p);
+#else
+    (void)p;
+    return requested; // No introspection available
+#endif
+}
+
+// ---------- Footprint Report ----------
+void writeFootprint(std::ostream& out, const std::vector<FootprintReport>& reports) {
+    for (const auto& r : reports)
+        out << r.name << ": sizeof " << r.size << ", align " << r.alignment
+            << ", allocated " << r.allocated << ", overhead " << r.overhead()
+            << ", waste at " << r.population << " = " << r.totalWaste()
+            << " bytes (pooled " << r.pooledWaste() << ")\n";
+}
+
+// ---------- Prewarming ----------
+namespace {
+
+// Demand summed per size class, so types sharing a pool add up instead of
+// each reserving "at least n" of the same pool
+struct PoolDemand {
+    std::size_t blockSize;
+    std::size_t blocks;
+    void (*reserve)(std::size_t);
+};
+
+template <class T>
+void reservePool(std::size_t n) {
+    PoolFor<T>::instance().reserve(n);
+}
+
+template <class T>
+void addPoolDemand(std::vector<PoolDemand>& demand, std::size_t n) {
+    for (auto& d : demand)
+        if (d.blockSize == SizeClassOf<T>::value) {
+            d.blocks += n;
+            return;
+        }
+    demand.push_back(PoolDemand{ SizeClassOf<T>::value, n, &reservePool<T> });
+}
+
+} // namespace
+
+void prewarmProducts(const PrewarmConfig& config) {
+    std::vector<PoolDemand> pools;
+    addPoolDemand<Truck>(pools, config.transports);
+    addPoolDemand<Ship>(pools, config.transports);
+    addPoolDemand<VictorianChair>(pools, config.chairs);
+    addPoolDemand<ModernChair>(pools, config.chairs);
+    addPoolDemand<House>(pools, config.houses);
+    for (const auto& d : pools)
+        d.reserve(d.blocks);
+
+    // Plain new: the allocator's bins are keyed by size, so sum by size too
+    std::map<std::size_t, std::size_t> heap;
+    heap[sizeof(Truck)] += config.transports;
+    heap[sizeof(Ship)] += config.transports;
+    heap[sizeof(VictorianChair)] += config.chairs;
+    heap[sizeof(ModernChair)] += config.chairs;
+    heap[sizeof(House)] += config.houses;
+    for (std::size_t parts = 1; parts <= 4; parts *= 2) // Growth of House::parts
+        heap[parts * sizeof(std::string)] += config.houses;
+    for (const auto& h : heap)
+        prewarmHeapBlocks(h.first, h.second);
+}
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AbstractFactory.h"
+#include "Builder.h"
+#include "FactoryMethod.h"
+#include "GenericFactory.h"
+#include "Instrumentation.h"
+
+//
+// ===========================
+// Product Footprint and Size-Class Pools
+// ===========================
+//
+// Intent: Show how much memory each product really costs once the general
+// purpose allocator has rounded it up and added its own header, and offer
+// pools that hand out exact 16-byte size classes instead.
+//
+// Key Roles:
+// - FootprintReport: sizeof, alignment, allocator and pool cost of one type
+// - SizeClassPool: free-list pool shared by all products of one size class
+// - PooledCreation: Factory creation policy backed by the size-class pools
+//
+
+// ---------- Allocator Introspection ----------
+// Bytes the allocator actually reserved for a block it returned
+std::size_t allocatedBlockSize(void* p, std::size_t requested);
+
+// ---------- Size Classes ----------
+const std::size_t sizeClassGranularity = 16;
+
+template <class T>
+struct SizeClassOf {
+    static_assert(alignof(T) <= sizeClassGranularity, "Over-aligned products need their own pool");
+    static const std::size_t value =
+        (sizeof(T) + sizeClassGranularity - 1) / sizeClassGranularity * sizeClassGranularity;
+};
+
+// ---------- Footprint Report ----------
+struct FootprintReport {
+    const char* name;
+    std::size_t size;        // sizeof
+    std::size_t alignment;   // alignof
+    std::size_t allocated;   // Bytes the general purpose allocator reserves
+    std::size_t pooled;      // Bytes a SizeClassPool block takes
+    std::size_t population;
+
+    std::size_t overhead() const { return allocated - size; }
+    std::size_t totalWaste() const { return overhead() * population; }
+    std::size_t pooledWaste() const { return (pooled - size) * population; }
+};
+
+template <class T>
+FootprintReport footprintOf(const char* name, std::size_t population) {
+    void* probe = ::operator new(sizeof(T));
+    std::size_t allocated = allocatedBlockSize(probe, sizeof(T));
+    ::operator delete(probe);
+    return FootprintReport{ name, sizeof(T), alignof(T), allocated,
+                            SizeClassOf<T>::value, population };
+}
+
+void writeFootprint(std::ostream& out, const std::vector<FootprintReport>& reports);
+
+// ---------- Size-Class Pool ----------
+template <std::size_t BlockSize>
+class SizeClassPool {
+public:
+    static const std::size_t blocksPerChunk = 256;
+
+    static SizeClassPool& instance() {
+        static SizeClassPool pool;
+        return pool;
+    }
+
+    void* allocate() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeList)
+            addChunk();
+        FreeBlock* block = freeList;
+        freeList = block->next;
+        ++live;
+        ++allocations;
+        return block;
+    }
+
+    void release(void* p) {
+        std::lock_guard<std::mutex> lock(mutex);
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = freeList;
+        freeList = block;
+        --live;
+    }
+
+    std::size_t liveCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return live;
+    }
+
+    std::size_t capacity() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return chunks.size() * blocksPerChunk;
+    }
+
+    // Monotonic allocation count, used to detect idle periods
+    std::uint64_t activity() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return allocations;
+    }
+
+    // Frees chunks with no live block, but never below `retain` reserved
+    // blocks: at least `retain` stay reserved (rounded up to whole chunks).
+    // Returns the number of chunks released.
+    std::size_t trim(std::size_t retain = 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (chunks.empty())
+            return 0;
+
+        // Chunk start addresses, sorted, to map a block to its chunk
+        std::vector<std::pair<const unsigned char*, std::size_t>> starts;
+        for (std::size_t c = 0; c < chunks.size(); ++c)
+            starts.emplace_back(chunks[c].get(), c);
+        std::sort(starts.begin(), starts.end(), ChunkOrder());
+        auto chunkOf = [&starts](const FreeBlock* b) {
+            auto key = std::make_pair(reinterpret_cast<const unsigned char*>(b), ~std::size_t(0));
+            return std::prev(std::upper_bound(starts.begin(), starts.end(), key, ChunkOrder()))->second;
+        };
+
+        std::vector<std::size_t> freeInChunk(chunks.size(), 0);
+        for (FreeBlock* b = freeList; b; b = b->next)
+            ++freeInChunk[chunkOf(b)];
+
+        std::vector<bool> release(chunks.size(), false);
+        std::size_t reserved = chunks.size() * blocksPerChunk, released = 0;
+        for (std::size_t c = 0; c < chunks.size() && reserved - blocksPerChunk >= retain; ++c) {
+            if (freeInChunk[c] == blocksPerChunk) {
+                release[c] = true;
+                reserved -= blocksPerChunk;
+                ++released;
+            }
+        }
+        if (released == 0)
+            return 0;
+
+        // Unlink blocks of released chunks, then drop the chunks themselves
+        FreeBlock** link = &freeList;
+        while (*link) {
+            if (release[chunkOf(*link)])
+                *link = (*link)->next;
+            else
+                link = &(*link)->next;
+        }
+        std::vector<std::unique_ptr<unsigned char[]>> kept;
+        for (std::size_t c = 0; c < chunks.size(); ++c)
+            if (!release[c])
+                kept.push_back(std::move(chunks[c]));
+        chunks.swap(kept);
+        return released;
+    }
+
+    // Grows the pool to at least n blocks up front. Threading each new block
+    // onto the free list writes to it, so its pages are faulted in now rather
+    // than on the first requests.
+    void reserve(std::size_t n) {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (chunks.size() * blocksPerChunk < n)
+            addChunk();
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    static_assert(BlockSize >= sizeof(FreeBlock), "Block too small for the free list");
+
+    // Live and reserved blocks are exported as gauges, one label per size class
+    SizeClassPool() {
+        const std::string labels = "{block_bytes=\"" + std::to_string(BlockSize) + "\"}";
+        liveGauge = factoryMetrics().addGauge(
+            "size_class_pool_live_blocks", "Blocks handed out by a SizeClassPool.",
+            [this] { return static_cast<double>(liveCount()); }, labels);
+        capacityGauge = factoryMetrics().addGauge(
+            "size_class_pool_capacity_blocks", "Blocks reserved by a SizeClassPool.",
+            [this] { return static_cast<double>(capacity()); }, labels);
+    }
+
+    void addChunk() {
+        std::unique_ptr<unsigned char[]> chunk(new unsigned char[BlockSize * blocksPerChunk]);
+        for (std::size_t i = blocksPerChunk; i-- > 0;) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk.get() + i * BlockSize);
+            block->next = freeList;
+            freeList = block;
+        }
+        chunks.push_back(std::move(chunk));
+    }
+
+    // Total order on addresses from different chunks
+    struct ChunkOrder {
+        bool operator()(const std::pair<const unsigned char*, std::size_t>& a,
+                        const std::pair<const unsigned char*, std::size_t>& b) const {
+            return std::less<const unsigned char*>()(a.first, b.first);
+        }
+    };
+
+    mutable std::mutex mutex;
+    FreeBlock* freeList = nullptr;
+    std::size_t live = 0;
+    std::uint64_t allocations = 0;
+    std::vector<std::unique_ptr<unsigned char[]>> chunks;
+    GaugeRegistration liveGauge;
+    GaugeRegistration capacityGauge;
+};
+
+template <class T>
+using PoolFor = SizeClassPool<SizeClassOf<T>::value>;
+
+// ---------- Pooled Creation Policy ----------
+struct PooledCreation {
+    struct Deleter {
+        void (*destroy)(void*) = nullptr;
+
+        template <class T>
+        void operator()(T* p) const {
+            if (p)
+                destroy(static_cast<void*>(p));
+        }
+    };
+
+    template <class Base, class Concrete>
+    static std::unique_ptr<Base, Deleter> create() {
+        void* memory = PoolFor<Concrete>::instance().allocate();
+        Concrete* product;
+        try {
+            product = new (memory) Concrete();
+        } catch (...) {
+            PoolFor<Concrete>::instance().release(memory);
+            throw;
+        }
+        return std::unique_ptr<Base, Deleter>(product, Deleter{ &destroy<Base, Concrete> });
+    }
+
+private:
+    template <class Base, class Concrete>
+    static void destroy(void* p) {
+        Concrete* product = static_cast<Concrete*>(static_cast<Base*>(p));
+        product->~Concrete();
+        PoolFor<Concrete>::instance().release(product);
+    }
+};
+
+using PooledTransportFactory = Factory<Transport, std::string, PooledCreation>;
+using PooledChairFactory = Factory<Chair, std::string, PooledCreation>;
+
+
+//
+// ===========================
+// Pool Prewarming
+// ===========================
+//
+// Intent: Pay for allocator growth and page faults once at startup instead of
+// on the first requests after a restart.
+//
+// - Pooled factories: each size-class pool is grown to the total demand of
+//   every product type that shares it (Truck, Ship and both chairs all land
+//   in the 16-byte class).
+// - planDelivery(), showFurniture() and Director, which use plain new: the
+//   system allocator is exercised with one burst of same-sized allocations so
+//   its free lists and pages are ready when real requests arrive. For houses
+//   that includes the part vector's buffers as it grows to 1, 2 and 4 parts.
+//
+
+// Counts are per concrete type: transports = 100 readies 100 trucks and
+// 100 ships
+struct PrewarmConfig {
+    std::size_t transports = 0;
+    std::size_t chairs = 0;
+    std::size_t houses = 0;
+};
+
+// Allocates and frees n blocks of the given size through the system allocator
+inline void prewarmHeapBlocks(std::size_t bytes, std::size_t n) {
+    std::vector<void*> blocks;
+    blocks.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        void* p = ::operator new(bytes);
+        *static_cast<volatile unsigned char*>(p) = 0; // Touch the page
+        blocks.push_back(p);
+    }
+    for (void* p : blocks)
+        ::operator delete(p);
+}
+
+template <class T>
+void prewarmHeap(std::size_t n) {
+    prewarmHeapBlocks(sizeof(T), n);
+}
+
+void prewarmProducts(const PrewarmConfig& config);
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "AbstractFactory.h"
+#include "FactoryMethod.h"
+#include "GenericFactory.h"
+
+//
+// ===========================
+// Speculative Pre-Creation
+// ===========================
+//
+// Intent: Keep a few products of each kind constructed ahead of demand so a
+// request hands out a ready object instead of building one. A background
+// thread refills the buffers in proportion to the recent demand mix.
+//
+// Key Roles:
+// - ReadyBuffer: per-key queues of ready products plus the demand estimate
+// - SpeculativeLogistics / SpeculativeFurnitureFactory: creators that draw
+//   from a ReadyBuffer, so planDelivery() and showFurniture() use it unchanged
+//
+// Products are built through Factory::make, so FactoryMetrics and the
+// create_transport/create_chair probes see them when they are constructed,
+// by the filler or on a miss, not when they are handed out.
+//
+
+template <class Base, class Key>
+class ReadyBuffer {
+public:
+    using ProductFactory = Factory<Base, Key, HeapCreation, MutexLocked>;
+    using Pointer = typename ProductFactory::Pointer;
+
+    // `capacity` ready products in total, split by each key's share of demand
+    explicit ReadyBuffer(std::size_t capacity, double smoothing = 0.05)
+        : capacity(capacity), smoothing(smoothing) {}
+
+    ~ReadyBuffer() { stop(); }
+
+    ReadyBuffer(const ReadyBuffer&) = delete;
+    ReadyBuffer& operator=(const ReadyBuffer&) = delete;
+
+    // Register every type before start()
+    template <class Concrete>
+    void registerType(const Key& key) {
+        factory.template registerType<Concrete>(key);
+        std::lock_guard<std::mutex> lock(mutex);
+        lanes[key];
+    }
+
+    // No-op if already started
+    void start() {
+        if (filler.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& lane : lanes)
+                lane.second.share = 1.0 / lanes.size(); // No history yet: even split
+            running = true;
+        }
+        filler = std::thread([this] { fill(); });
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        wake.notify_all();
+        if (filler.joinable())
+            filler.join();
+    }
+
+    Pointer acquire(const Key& key) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& lane : lanes) // Exponentially weighted share of demand
+                lane.second.share = lane.second.share * (1.0 - smoothing)
+                    + (lane.first == key ? smoothing : 0.0);
+            auto it = lanes.find(key);
+            if (it != lanes.end() && !it->second.ready.empty()) {
+                Pointer product = std::move(it->second.ready.back());
+                it->second.ready.pop_back();
+                ++hitCount;
+                wake.notify_one();
+                return product;
+            }
+            ++missCount;
+        }
+        wake.notify_one();
+        return factory.create(key); // Miss: construct on the caller's thread
+    }
+
+    std::uint64_t hits() const { std::lock_guard<std::mutex> lock(mutex); return hitCount; }
+    std::uint64_t misses() const { std::lock_guard<std::mutex> lock(mutex); return missCount; }
+
+    double hitRate() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::uint64_t total = hitCount + missCount;
+        return total == 0 ? 0.0 : static_cast<double>(hitCount) / total;
+    }
+
+private:
+    struct Lane {
+        std::vector<Pointer> ready;
+        double share = 0.0;
+    };
+
+    void fill() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (running) {
+            // Pick the lane furthest below its target
+            const Key* neediest = nullptr;
+            std::size_t deficit = 0;
+            for (auto& lane : lanes) {
+                std::size_t target = static_cast<std::size_t>(lane.second.share * capacity + 0.5);
+                if (target > lane.second.ready.size() && target - lane.second.ready.size() > deficit) {
+                    deficit = target - lane.second.ready.size();
+                    neediest = &lane.first;
+                }
+            }
+            if (!neediest) {
+                wake.wait(lock);
+                continue;
+            }
+            Key key = *neediest;
+            lock.unlock();
+            Pointer product = factory.create(key); // Construct outside the lock
+            lock.lock();
+            lanes[key].ready.push_back(std::move(product));
+        }
+    }
+
+    ProductFactory factory;
+    std::size_t capacity;
+    double smoothing;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::map<Key, Lane> lanes;
+    std::uint64_t hitCount = 0;
+    std::uint64_t missCount = 0;
+    bool running = false;
+    std::thread filler;
+};
+
+// ---------- Creators Drawing From Ready Buffers ----------
+class SpeculativeLogistics : public Logistics {
+public:
+    SpeculativeLogistics(ReadyBuffer<Transport, std::string>& buffer, std::string key)
+        : buffer(buffer), key(std::move(key)) {}
+
+    // HeapCreation products may be released to a caller that deletes them
+    Transport* createTransport() const override { return buffer.acquire(key).release(); }
+
+private:
+    ReadyBuffer<Transport, std::string>& buffer;
+    std::string key;
+};
+
+class SpeculativeFurnitureFactory : public FurnitureFactory {
+public:
+    SpeculativeFurnitureFactory(ReadyBuffer<Chair, std::string>& buffer, std::string key)
+        : buffer(buffer), key(std::move(key)) {}
+
+    Chair* createChair() const override { return buffer.acquire(key).release(); }
+
+private:
+    ReadyBuffer<Chair, std::string>& buffer;
+    std::string key;
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Builder.h"
+
+//
+// ===========================
+// Incremental Rebuild
+// ===========================
+//
+// Intent: Remember which recipe, and which steps of it, produced each house.
+// When a recipe changes, only houses built from it are touched, and each of
+// them is rebuilt starting at the first step that differs.
+//
+// Every house of a recipe is kept in step with it, so the per-step data
+// lives once per recipe: its steps and where each step's parts end. A house
+// only records its 32-bit recipe id; an edit finds the affected houses by
+// scanning those ids. Houses are stored contiguously and rebuilt in place
+// (InPlaceHouseBuilder): a rebuild truncates at the first changed step and
+// replays the new suffix.
+//
+
+class RecipeTracker {
+public:
+    RecipeTracker() { director.setBuilder(&builder); }
+
+    RecipeTracker(const RecipeTracker&) = delete;
+    RecipeTracker& operator=(const RecipeTracker&) = delete;
+
+    void defineRecipe(const std::string& name, const Recipe& steps) {
+        auto found = ids.find(name);
+        if (found != ids.end()) {
+            updateRecipe(name, steps);
+            return;
+        }
+        ids.emplace(name, static_cast<std::uint32_t>(recipes.size()));
+        recipes.emplace_back();
+        recipes.back().steps = steps;
+    }
+
+    // Returns the id of the new house. Throws std::out_of_range for an
+    // unknown recipe.
+    std::size_t build(const std::string& recipeName) {
+        std::uint32_t id = ids.at(recipeName);
+        houses.emplace_back();
+        houseRecipe.push_back(id);
+        buildFrom(recipes[id], houses.back(), 0);
+        return houses.size() - 1;
+    }
+
+    // Replaces a recipe and rebuilds its dependents; returns steps rebuilt
+    std::size_t updateRecipe(const std::string& name, const Recipe& steps) {
+        auto found = ids.find(name);
+        if (found == ids.end()) {
+            defineRecipe(name, steps);
+            return 0;
+        }
+        std::uint32_t id = found->second;
+        RecipeState& recipe = recipes[id];
+        std::size_t first = 0; // Same for every dependent: compared once
+        while (first < recipe.steps.size() && first < steps.size() && recipe.steps[first] == steps[first])
+            ++first;
+        if (first == recipe.steps.size() && first == steps.size())
+            return 0;
+
+        std::size_t keepParts = first == 0 ? 0 : recipe.partEnds[first - 1];
+        recipe.steps = steps;
+        recipe.partEnds.resize(first); // The first rebuild records the rest
+        std::size_t affected = 0;
+        for (std::size_t house = 0; house < houses.size(); ++house) {
+            if (houseRecipe[house] != id)
+                continue;
+            houses[house].truncate(keepParts);
+            buildFrom(recipe, houses[house], first);
+            ++affected;
+        }
+        return (steps.size() - first) * affected;
+    }
+
+    const House& house(std::size_t id) const { return houses[id]; }
+    std::size_t size() const { return houses.size(); }
+
+private:
+    struct RecipeState {
+        Recipe steps;
+        std::vector<std::size_t> partEnds; // Part count after each step
+    };
+
+    void buildFrom(RecipeState& recipe, House& house, std::size_t first) {
+        builder.setTarget(&house);
+        if (recipe.partEnds.size() == recipe.steps.size()) {
+            director.build(recipe.steps, first, [](std::size_t) {});
+        } else {
+            director.build(recipe.steps, first, [&](std::size_t i) {
+                if (i == recipe.partEnds.size())
+                    recipe.partEnds.push_back(house.partCount());
+            });
+        }
+        builder.finishHouse();
+    }
+
+    InPlaceHouseBuilder builder;
+    Director director;
+    std::map<std::string, std::uint32_t> ids;
+    std::vector<RecipeState> recipes;
+    std::vector<House> houses;
+    std::vector<std::uint32_t> houseRecipe; // Recipe id per house
+};
@@ -0,0 +1,160 @@
+#include "SamplingProfiler.h"
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+SamplingProfiler& SamplingProfiler::instance() {
+    static SamplingProfiler profiler;
+    return profiler;
+}
+
+void SamplingProfiler::start(int hz, std::size_t capacity) {
+    if (hz < 1 || hz > 1000000)
+        throw std::invalid_argument("SamplingProfiler: hz must be between 1 and 1000000");
+    if (running)
+        throw std::logic_error("SamplingProfiler: already running");
+    samples.assign(capacity, Sample());
+    next.store(0, std::memory_order_relaxed);
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_sigaction = &SamplingProfiler::onSignal;
+    action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &previousAction) != 0)
+        throw std::runtime_error("SamplingProfiler: cannot install SIGPROF handler");
+
+    itimerval timer;
+    timer.it_interval.tv_sec = hz == 1 ? 1 : 0; // tv_usec must stay below 1000000
+    timer.it_interval.tv_usec = hz == 1 ? 0 : 1000000 / hz;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, &previousTimer) != 0) {
+        sigaction(SIGPROF, &previousAction, nullptr);
+        throw std::runtime_error("SamplingProfiler: cannot start profiling timer");
+    }
+    running = true;
+}
+
+void SamplingProfiler::stop() {
+    if (!running)
+        return;
+    setitimer(ITIMER_PROF, &previousTimer, nullptr); // Usually "off"
+    sigaction(SIGPROF, &previousAction, nullptr);
+    running = false;
+}
+
+void SamplingProfiler::writeFolded(std::ostream& out, const std::string& rootFrame) const {
+    std::map<void*, std::string> names;
+    std::map<std::string, std::size_t> stacks;
+    for (std::size_t s = 0; s < sampleCount(); ++s) {
+        const Sample& sample = samples[s];
+        std::string stack = rootFrame;
+        for (int f = sample.depth - 1; f >= 0; --f) {
+            if (!stack.empty())
+                stack += ';';
+            stack += symbolName(sample.frames[f], names);
+        }
+        if (stack.size() > rootFrame.size())
+            ++stacks[stack];
+    }
+    for (const auto& entry : stacks)
+        out << entry.first << ' ' << entry.second << '\n';
+}
+
+// No sane frame is this large; a bigger jump means the chain is broken
+static const std::uintptr_t maxFrameBytes = 1024 * 1024;
+
+// Copies n bytes from this process's memory, failing instead of faulting on
+// unmapped addresses. process_vm_readv is a plain system call, so it is
+// async-signal-safe.
+static bool readMemory(const void* address, void* out, std::size_t n) {
+    iovec local = { out, n };
+    iovec remote = { const_cast<void*>(address), n };
+    return process_vm_readv(getpid(), &local, 1, &remote, 1, 0) == static_cast<ssize_t>(n);
+}
+
+// Async-signal-safe: an atomic increment, then a frame-pointer walk into
+// preallocated memory. No locks, no allocation, errno preserved.
+void SamplingProfiler::onSignal(int, siginfo_t*, void* context) {
+    int savedErrno = errno;
+    SamplingProfiler& self = instance();
+    std::size_t slot = self.next.fetch_add(1, std::memory_order_relaxed);
+    if (slot < self.samples.size()) {
+        Sample& sample = self.samples[slot];
+        const ucontext_t* uc = static_cast<const ucontext_t*>(context);
+#if defined(__x86_64__)
+        std::uintptr_t pc = static_cast<std::uintptr_t>(uc->uc_mcontext.gregs[REG_RIP]);
+        std::uintptr_t fp = static_cast<std::uintptr_t>(uc->uc_mcontext.gregs[REG_RBP]);
+        std::uintptr_t sp = static_cast<std::uintptr_t>(uc->uc_mcontext.gregs[REG_RSP]);
+#elif defined(__aarch64__)
+        std::uintptr_t pc = static_cast<std::uintptr_t>(uc->uc_mcontext.pc);
+        std::uintptr_t fp = static_cast<std::uintptr_t>(uc->uc_mcontext.regs[29]);
+        std::uintptr_t sp = static_cast<std::uintptr_t>(uc->uc_mcontext.sp);
+#else
+        std::uintptr_t pc = 0, fp = 0, sp = 0;
+        (void)uc;
+#endif
+        int depth = 0;
+        if (pc)
+            sample.frames[depth++] = reinterpret_cast<void*>(pc);
+        // Each frame holds {caller's frame pointer, return address}; frames
+        // only get older towards higher addresses
+        std::uintptr_t floor = sp;
+        while (depth < maxDepth && fp >= floor && fp % sizeof(void*) == 0 && fp - floor < maxFrameBytes) {
+            std::uintptr_t frame[2];
+            if (!readMemory(reinterpret_cast<const void*>(fp), frame, sizeof(frame)) || frame[1] == 0)
+                break;
+            sample.frames[depth++] = reinterpret_cast<void*>(frame[1] - 1); // Inside the call
+            floor = fp + sizeof(frame);
+            fp = frame[0];
+        }
+        sample.depth = depth;
+    }
+    errno = savedErrno;
+}
+
+const std::string& SamplingProfiler::symbolName(void* address, std::map<void*, std::string>& cache) {
+    auto it = cache.find(address);
+    if (it != cache.end())
+        return it->second;
+
+    std::string name;
+    char** symbols = backtrace_symbols(&address, 1);
+    if (symbols) {
+        // Format: "binary(mangled+0x1f) [0x...]"
+        std::string raw = symbols[0];
+        std::free(symbols);
+        std::size_t open = raw.find('('), plus = raw.find('+', open);
+        if (open != std::string::npos && plus != std::string::npos && plus > open + 1) {
+            std::string mangled = raw.substr(open + 1, plus - open - 1);
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+            name = status == 0 ? demangled : mangled;
+            std::free(demangled);
+        }
+    }
+    if (name.empty()) {
+        char hex[2 + 2 * sizeof(void*) + 1];
+        std::snprintf(hex, sizeof(hex), "%p", address);
+        name = hex;
+    }
+    // Semicolons separate frames in the folded format
+    std::replace(name.begin(), name.end(), ';', ':');
+    return cache.emplace(address, name).first->second;
+}
+
+#endif // __linux__
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//
+// ===========================
+// Slot Map Product Storage
+// ===========================
+//
+// Intent: Keep products of one concrete type packed in a contiguous array and
+// hand out small generational handles instead of raw pointers. A handle to an
+// erased product is detected as stale rather than dangling.
+//
+// Key Roles:
+// - Handle: 32-bit slot index + 32-bit generation
+// - Slot: maps a handle index to the product's position in the dense array
+// - Dense array: the products themselves, iterated without indirection
+//
+
+// ---------- Handle ----------
+struct SlotHandle {
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0;
+};
+
+// ---------- Slot Map ----------
+template <class T>
+class SlotMap {
+public:
+    template <class... Args>
+    SlotHandle emplace(Args&&... args) {
+        std::uint32_t index;
+        if (freeHead != npos) {
+            index = freeHead;
+            freeHead = slots[index].position; // Free slots chain through position
+            --freeCount;
+        } else {
+            index = static_cast<std::uint32_t>(slots.size());
+            slots.push_back(Slot());
+            slots[index].generation = trimmedGeneration;
+        }
+        slots[index].position = static_cast<std::uint32_t>(values.size());
+        values.emplace_back(std::forward<Args>(args)...);
+        owners.push_back(index);
+        ++changes;
+        return SlotHandle{ index, slots[index].generation };
+    }
+
+    // Constant time: the last product is moved into the erased one's place
+    bool erase(SlotHandle h) {
+        if (!contains(h))
+            return false;
+        std::uint32_t position = slots[h.index].position;
+        std::uint32_t last = static_cast<std::uint32_t>(values.size() - 1);
+        if (position != last) {
+            values[position] = std::move(values[last]);
+            owners[position] = owners[last];
+            slots[owners[position]].position = position;
+        }
+        values.pop_back();
+        owners.pop_back();
+
+        Slot& slot = slots[h.index];
+        ++slot.generation; // Invalidates every outstanding handle
+        slot.position = freeHead;
+        freeHead = h.index;
+        ++freeCount;
+        ++changes;
+        return true;
+    }
+
+    bool contains(SlotHandle h) const {
+        return h.index < slots.size() && slots[h.index].generation == h.generation
+            && slots[h.index].position < values.size() && owners[slots[h.index].position] == h.index;
+    }
+
+    // Emplaces and erases so far; an idle store's count stops moving
+    std::uint64_t activity() const { return changes; }
+
+    T* get(SlotHandle h) { return contains(h) ? &values[slots[h.index].position] : nullptr; }
+    const T* get(SlotHandle h) const { return contains(h) ? &values[slots[h.index].position] : nullptr; }
+
+    std::size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    std::size_t capacity() const { return values.capacity(); }
+
+    void reserve(std::size_t n) {
+        values.reserve(n);
+        owners.reserve(n);
+        slots.reserve(n);
+    }
+
+    struct Report {
+        std::size_t live;          // Products
+        std::size_t slots;         // Slot table entries, live and free
+        std::size_t freeSlots;     // Length of the free list
+        std::size_t reservedBytes; // Products, owners and slot table
+        std::size_t liveBytes;     // The part of reservedBytes in use
+        double fragmentation;      // 1 - liveBytes / reservedBytes
+    };
+
+    Report report() const {
+        const std::size_t perProduct = sizeof(T) + sizeof(std::uint32_t);
+        Report r;
+        r.live = values.size();
+        r.slots = slots.size();
+        r.freeSlots = freeCount;
+        r.reservedBytes = values.capacity() * sizeof(T) + owners.capacity() * sizeof(std::uint32_t)
+            + slots.capacity() * sizeof(Slot);
+        r.liveBytes = values.size() * perProduct + values.size() * sizeof(Slot);
+        r.fragmentation = r.reservedBytes == 0 ? 0.0
+            : 1.0 - static_cast<double>(r.liveBytes) / r.reservedBytes;
+        return r;
+    }
+
+    // Share of reserved storage, slot table included, not in live use
+    double fragmentation() const { return report().fragmentation; }
+
+    // Relocates live products into a tightly sized block and releases the old
+    // one, and drops free slots at the end of the slot table. Handles stay
+    // valid because they resolve through the slot table. Intended for idle
+    // periods: it costs one move per live product and one pass over the slot
+    // table. The freed blocks go back to the allocator; returning its pages
+    // to the system is left to the caller (IdleTrimmer::watchStore does it
+    // once per poll).
+    void compact() {
+        std::size_t keep = slots.size();
+        while (keep > 0 && !isLive(static_cast<std::uint32_t>(keep - 1))) {
+            // A slot recreated at a trimmed index must not revive old handles
+            std::uint32_t next = slots[keep - 1].generation + 1;
+            if (next > trimmedGeneration)
+                trimmedGeneration = next;
+            --keep;
+        }
+        if (keep < slots.size()) {
+            slots.resize(keep);
+            freeHead = npos; // Rebuild the chain without the trimmed slots
+            freeCount = 0;
+            for (std::uint32_t i = static_cast<std::uint32_t>(keep); i-- > 0;) {
+                if (isLive(i))
+                    continue;
+                slots[i].position = freeHead; // Lowest index is reused first
+                freeHead = i;
+                ++freeCount;
+            }
+        }
+        values.shrink_to_fit();
+        owners.shrink_to_fit();
+        slots.shrink_to_fit();
+    }
+
+    // Dense iteration over live products
+    typename std::vector<T>::iterator begin() { return values.begin(); }
+    typename std::vector<T>::iterator end() { return values.end(); }
+    typename std::vector<T>::const_iterator begin() const { return values.begin(); }
+    typename std::vector<T>::const_iterator end() const { return values.end(); }
+
+private:
+    static const std::uint32_t npos = 0xFFFFFFFFu;
+
+    struct Slot {
+        std::uint32_t position = npos;
+        std::uint32_t generation = 0;
+    };
+
+    std::vector<T> values;            // Dense products
+    std::vector<std::uint32_t> owners; // Slot index of each dense product
+    bool isLive(std::uint32_t index) const {
+        std::uint32_t position = slots[index].position;
+        return position < owners.size() && owners[position] == index;
+    }
+
+    std::vector<Slot> slots;
+    std::uint32_t freeHead = npos;
+    std::size_t freeCount = 0;
+    std::uint32_t trimmedGeneration = 0; // First generation for re-grown slots
+    std::uint64_t changes = 0;
+};
+
+// ---------- Creating Products Into Storage ----------
+template <class Concrete>
+SlotHandle createInto(SlotMap<Concrete>& store) {
+    return store.emplace();
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Builder.h"
+#include "TrivialProducts.h"
+
+//
+// ===========================
+// Speculative House Builds
+// ===========================
+//
+// Intent: Let a planner try many recipe variants through Director and throw
+// most of them away cheaply. ArenaHouseBuilder builds PlainHouses into a
+// TrivialArena; a checkpoint records the arena position and the builder's
+// state, and rollback() returns to it in O(1) with no frees or destructors.
+//
+// It produces PlainHouses rather than House objects, so it is a step builder:
+// finishHouse() closes the current house, available from houses().
+//
+// Usage:
+//     ArenaHouseBuilder::Checkpoint cp = builder.checkpoint();
+//     director.build(variant);
+//     builder.finishHouse();
+//     if (!accept(builder.houses().back()))
+//         builder.rollback(cp);
+//
+
+class ArenaHouseBuilder final : public HouseStepBuilder {
+public:
+    explicit ArenaHouseBuilder(TrivialArena& arena) : arena(arena) {}
+
+    void buildWalls() override { current().addPart(BuildStep::Walls); }
+    void buildDoors() override { current().addPart(BuildStep::Doors); }
+    void buildWindows() override { current().addPart(BuildStep::Windows); }
+
+    void finishHouse() override {
+        finished.push_back(&current());
+        inProgress = nullptr;
+    }
+
+    const std::vector<const PlainHouse*>& houses() const { return finished; }
+
+    struct Checkpoint {
+        TrivialArena::Marker arenaMark;
+        std::size_t finishedCount;
+        PlainHouse* inProgress;
+        std::size_t partCount;
+    };
+
+    Checkpoint checkpoint() const {
+        return Checkpoint{ arena.mark(), finished.size(), inProgress,
+                           inProgress ? inProgress->partCount : std::size_t(0) };
+    }
+
+    void rollback(const Checkpoint& cp) {
+        arena.release(cp.arenaMark);
+        finished.resize(cp.finishedCount); // Shrinking: no allocation
+        inProgress = cp.inProgress;
+        if (inProgress)
+            inProgress->partCount = static_cast<std::uint8_t>(cp.partCount);
+    }
+
+private:
+    PlainHouse& current() {
+        if (!inProgress)
+            inProgress = arena.create<PlainHouse>();
+        return *inProgress;
+    }
+
+    TrivialArena& arena;
+    std::vector<const PlainHouse*> finished;
+    PlainHouse* inProgress = nullptr;
+};
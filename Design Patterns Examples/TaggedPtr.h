@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "AbstractFactory.h"
+#include "FactoryMethod.h"
+
+//
+// ===========================
+// Tagged Product Pointers
+// ===========================
+//
+// Intent: Store the concrete product kind in the unused low bits of a product
+// pointer, so type tests and kind-based dispatch read only the pointer and
+// never touch the (possibly cold) object or its vtable.
+//
+// Key Roles:
+// - Kind enum: dense id per concrete product of a hierarchy
+// - ProductTag: maps each concrete product to its kind at compile time
+// - TaggedPtr: non-owning pointer + kind packed into one word
+//
+
+// ---------- Dense Kind Ids ----------
+enum class TransportKind : std::uintptr_t { Truck, Ship };
+enum class ChairStyle : std::uintptr_t { Victorian, Modern };
+
+template <class Concrete>
+struct ProductTag;
+
+template <> struct ProductTag<Truck> { static const TransportKind value = TransportKind::Truck; };
+template <> struct ProductTag<Ship> { static const TransportKind value = TransportKind::Ship; };
+template <> struct ProductTag<VictorianChair> { static const ChairStyle value = ChairStyle::Victorian; };
+template <> struct ProductTag<ModernChair> { static const ChairStyle value = ChairStyle::Modern; };
+
+// ---------- Tagged Pointer ----------
+template <class Base, class Kind>
+class TaggedPtr {
+public:
+    static const std::uintptr_t tagMask = 0x3;
+    static_assert(alignof(Base) > tagMask, "Base alignment leaves no free pointer bits");
+
+    TaggedPtr() = default;
+
+    // A null product gives the null TaggedPtr, which carries no kind
+    template <class Concrete>
+    static TaggedPtr make(Concrete* p) {
+        static_assert(std::is_base_of<Base, Concrete>::value, "Concrete must derive from Base");
+        if (!p)
+            return TaggedPtr();
+        Kind kind = ProductTag<Concrete>::value;
+        return TaggedPtr(reinterpret_cast<std::uintptr_t>(static_cast<Base*>(p))
+                         | static_cast<std::uintptr_t>(kind));
+    }
+
+    explicit operator bool() const { return bits != 0; }
+
+    // Neither call dereferences the product; kind() is meaningless for null
+    Kind kind() const { return static_cast<Kind>(bits & tagMask); }
+
+    template <class Concrete>
+    bool is() const { return bits != 0 && kind() == ProductTag<Concrete>::value; }
+
+    Base* get() const { return reinterpret_cast<Base*>(bits & ~tagMask); }
+    Base* operator->() const { return get(); }
+
+    template <class Concrete>
+    Concrete* as() const { return is<Concrete>() ? static_cast<Concrete*>(get()) : nullptr; }
+
+private:
+    explicit TaggedPtr(std::uintptr_t b) : bits(b) {}
+    std::uintptr_t bits = 0;
+};
+
+using TaggedTransport = TaggedPtr<Transport, TransportKind>;
+using TaggedChair = TaggedPtr<Chair, ChairStyle>;
+
+// ---------- Kind-Based Dispatch ----------
+// Switches on the tag and calls the concrete product non-virtually.
+// Throws std::invalid_argument for a null pointer.
+inline std::string deliverTagged(TaggedTransport t) {
+    if (!t)
+        throw std::invalid_argument("deliverTagged: null transport");
+    switch (t.kind()) {
+    case TransportKind::Truck: return static_cast<Truck*>(t.get())->Truck::deliver();
+    case TransportKind::Ship: return static_cast<Ship*>(t.get())->Ship::deliver();
+    }
+    return t->deliver();
+}
+
+inline std::string typeTagged(TaggedChair c) {
+    if (!c)
+        throw std::invalid_argument("typeTagged: null chair");
+    switch (c.kind()) {
+    case ChairStyle::Victorian: return static_cast<VictorianChair*>(c.get())->VictorianChair::type();
+    case ChairStyle::Modern: return static_cast<ModernChair*>(c.get())->ModernChair::type();
+    }
+    return c->type();
+}
@@ -0,0 +1,631 @@
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <initializer_list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Builder.h"
+#include "CityBuilder.h"
+#include "ConcurrentHouse.h"
+#include "DeliveryManifest.h"
+#include "FanOutBuilder.h"
+#include "IdleTrimmer.h"
+#include "JsonWriter.h"
+#include "MetricsExport.h"
+#include "OrderIngestion.h"
+#include "ProductPools.h"
+#include "ReadyBuffer.h"
+#include "RecipeTracker.h"
+#include "SamplingProfiler.h"
+#include "SlotMap.h"
+#include "SpeculativeBuild.h"
+#include "TaggedPtr.h"
+#include "TrivialProducts.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+//
+// ===========================
+// Tests
+// ===========================
+//
+// Behavioural checks for the storage, builder and I/O extensions. Every
+// failing CHECK prints its location; the exit code is the failure count, so
+// CTest reports the run as failed if any check fails.
+//
+
+static int failures = 0;
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            ++failures;                                                         \
+        }                                                                       \
+    } while (0)
+
+static std::vector<std::string> parts(std::initializer_list<const char*> names) {
+    return std::vector<std::string>(names.begin(), names.end());
+}
+
+// ---------- SlotMap ----------
+static void slotMapStaleHandles() {
+    SlotMap<int> store;
+    SlotHandle a = store.emplace(1);
+    SlotHandle b = store.emplace(2);
+    CHECK(store.erase(a));
+    CHECK(!store.contains(a));
+    CHECK(store.get(a) == nullptr);
+    CHECK(!store.erase(a)); // Second erase of the same handle is refused
+
+    SlotHandle c = store.emplace(3); // Reuses a's slot with a new generation
+    CHECK(c.index == a.index);
+    CHECK(c.generation != a.generation);
+    CHECK(!store.contains(a));
+    CHECK(store.get(c) && *store.get(c) == 3);
+    CHECK(store.get(b) && *store.get(b) == 2); // Moved in the dense array, still resolves
+}
+
+static void slotMapCompaction() {
+    SlotMap<int> store;
+    std::vector<SlotHandle> handles;
+    for (int i = 0; i < 100; ++i)
+        handles.push_back(store.emplace(i));
+    for (int i = 10; i < 100; ++i)
+        store.erase(handles[i]);
+    store.erase(handles[3]);
+    CHECK(store.report().freeSlots == 91);
+
+    store.compact();
+    SlotMap<int>::Report report = store.report();
+    CHECK(report.slots == 10); // Trailing free slots trimmed
+    CHECK(report.freeSlots == 1);
+    CHECK(report.fragmentation < 0.2);
+    for (int i = 0; i < 10; ++i)
+        CHECK(store.contains(handles[i]) == (i != 3));
+
+    // Re-grown slots must not revive handles to trimmed ones
+    SlotHandle reused = store.emplace(-1);
+    CHECK(reused.index == 3);
+    bool revived = false;
+    for (int i = 0; i < 100; ++i) {
+        SlotHandle h = store.emplace(i);
+        for (int old = 10; old < 100; ++old)
+            revived = revived || (handles[old].index == h.index && store.contains(handles[old]));
+    }
+    CHECK(!revived);
+}
+
+// ---------- TaggedPtr ----------
+static void taggedPtrNull() {
+    TaggedTransport null = TaggedTransport::make(static_cast<Ship*>(nullptr));
+    CHECK(!null);
+    CHECK(!null.is<Ship>());
+    CHECK(!null.is<Truck>());
+    CHECK(null.as<Ship>() == nullptr);
+    bool threw = false;
+    try {
+        deliverTagged(null);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    Ship ship;
+    TaggedTransport tagged = TaggedTransport::make(&ship);
+    CHECK(tagged && tagged.is<Ship>() && !tagged.is<Truck>());
+    CHECK(tagged.as<Ship>() == &ship);
+    CHECK(deliverTagged(tagged) == "Delivery by Ship");
+}
+
+// ---------- ConcurrentHouse ----------
+static void concurrentHouseDeterministicOrder() {
+    for (int run = 0; run < 20; ++run) {
+        ConcurrentHouse house;
+        std::vector<std::thread> workers;
+        for (unsigned id = 4; id-- > 0;) // Start in reverse to vary claim order
+            workers.emplace_back([&house, id] {
+                for (int i = 0; i < 100; ++i)
+                    house.addPart(id, std::to_string(id) + ":" + std::to_string(i));
+            });
+        for (auto& t : workers)
+            t.join();
+
+        std::unique_ptr<House> result(house.finalize());
+        CHECK(result->partCount() == 400);
+        bool ordered = true;
+        for (std::size_t k = 0; k < result->partCount(); ++k)
+            ordered = ordered && result->getParts()[k] == std::to_string(k / 100) + ":" + std::to_string(k % 100);
+        CHECK(ordered);
+    }
+}
+
+static void concurrentHouseCapacity() {
+    ConcurrentHouse house;
+    for (std::size_t i = 0; i < ConcurrentHouse::maxParts; ++i)
+        house.addPart(0, "Walls");
+    bool threw = false;
+    try {
+        house.addPart(1, "Doors");
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::unique_ptr<House> result(house.finalize()); // Must not read past capacity
+    CHECK(result->partCount() == ConcurrentHouse::maxParts);
+    CHECK(result->getParts().back() == "Walls");
+}
+
+// ---------- CityBuilder ----------
+static void cityBuilderBuildsInPlace() {
+    std::unique_ptr<City> city(CityBuilder(8, 50).build(4));
+    CHECK(city->blockCount() == 8);
+    CHECK(city->houseCount() == 400);
+    bool complete = true;
+    for (std::size_t b = 0; b < city->blockCount(); ++b)
+        for (const House& house : city->block(b))
+            complete = complete && house.getParts() == parts({ "Walls", "Doors", "Windows" });
+    CHECK(complete);
+}
+
+// ---------- RecipeTracker ----------
+static void recipeTrackerSuffixRebuild() {
+    RecipeTracker tracker;
+    tracker.defineRecipe("cottage", { BuildStep::Walls, BuildStep::Doors });
+    tracker.defineRecipe("shed", { BuildStep::Walls });
+    std::size_t cottage = tracker.build("cottage");
+    std::size_t shed = tracker.build("shed");
+    CHECK(tracker.house(cottage).getParts() == parts({ "Walls", "Doors" }));
+
+    // Shared prefix is kept; only the changed suffix is rebuilt
+    CHECK(tracker.updateRecipe("cottage", { BuildStep::Walls, BuildStep::Windows, BuildStep::Doors }) == 2);
+    CHECK(tracker.house(cottage).getParts() == parts({ "Walls", "Windows", "Doors" }));
+    CHECK(tracker.house(shed).getParts() == parts({ "Walls" })); // Other recipe untouched
+
+    CHECK(tracker.updateRecipe("cottage", { BuildStep::Walls, BuildStep::Windows, BuildStep::Doors }) == 0);
+
+    // Every house of a recipe follows it; step boundaries are per recipe
+    std::size_t second = tracker.build("cottage");
+    CHECK(tracker.updateRecipe("cottage", { BuildStep::Walls, BuildStep::Windows, BuildStep::Windows }) == 2);
+    CHECK(tracker.house(cottage).getParts() == parts({ "Walls", "Windows", "Windows" }));
+    CHECK(tracker.house(second).getParts() == parts({ "Walls", "Windows", "Windows" }));
+    CHECK(tracker.house(shed).getParts() == parts({ "Walls" }));
+
+    CHECK(tracker.updateRecipe("cottage", {}) == 0);
+    CHECK(tracker.house(cottage).partCount() == 0);
+    CHECK(tracker.house(second).partCount() == 0);
+    CHECK(tracker.updateRecipe("cottage", { BuildStep::Doors }) == 2);
+    CHECK(tracker.house(second).getParts() == parts({ "Doors" }));
+}
+
+// ---------- Fan-Out Builders ----------
+static void fanOutBuildersReturnHouses() {
+    Director director;
+    SimpleHouseBuilder objects;
+    HouseTextBuilder text;
+    HouseStatsBuilder stats;
+
+    FanOutBuilder dynamic(objects, { &text, &stats });
+    director.setBuilder(&dynamic);
+    director.buildMinimalHouse();
+    std::unique_ptr<House> first(dynamic.getResult());
+    CHECK(first && first->getParts() == parts({ "Walls", "Doors" }));
+
+    auto fixed = fanOut(objects, text, stats);
+    director.setBuilder(&fixed);
+    director.buildFullHouse();
+    std::unique_ptr<House> second(fixed.getResult());
+    CHECK(second && second->partCount() == 3);
+
+    CHECK(text.bytes() == "Walls,Doors\nWalls,Doors,Windows\n");
+    CHECK(stats.stats().size() == 2);
+    CHECK(stats.stats()[1].windows == 1);
+}
+
+// ---------- Director Metrics ----------
+static std::uint64_t recorded(const LatencyHistogram& h) {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i <= LatencyHistogram::bucketCount; ++i)
+        total += h.bucket(i);
+    return total;
+}
+
+static void directorCountsRecipes() {
+    FactoryMetrics& m = factoryMetrics();
+    std::uint64_t houses = m.housesDirected.value();
+    std::uint64_t timed = recorded(m.directorLatency);
+    Director director;
+    SimpleHouseBuilder builder;
+    director.setBuilder(&builder);
+    director.build(Recipe{ BuildStep::Walls, BuildStep::Windows });
+    std::unique_ptr<House> house(builder.getResult());
+    CHECK(house->partCount() == 2);
+    CHECK(m.housesDirected.value() == houses + 1);
+    CHECK(recorded(m.directorLatency) == timed + 1);
+
+    RecipeTracker tracker; // Suffix rebuilds go through Director too
+    tracker.defineRecipe("shed", { BuildStep::Walls });
+    tracker.build("shed");
+    tracker.updateRecipe("shed", { BuildStep::Walls, BuildStep::Doors });
+    CHECK(m.housesDirected.value() == houses + 3);
+}
+
+// ---------- Gauges ----------
+static void gaugesUnregisterAndExportPools() {
+    PoolFor<Truck>::instance(); // Pools register their gauges on first use
+    std::string before;
+    {
+        std::vector<int> store(3);
+        GaugeRegistration gauge = factoryMetrics().addGauge(
+            "test_store_size", "Test store.", [&store] { return static_cast<double>(store.size()); });
+        std::ostringstream scrape;
+        writePrometheus(scrape);
+        before = scrape.str();
+    }
+    CHECK(before.find("test_store_size 3\n") != std::string::npos);
+    CHECK(before.find("size_class_pool_live_blocks{block_bytes=\"16\"}") != std::string::npos);
+    CHECK(before.find("size_class_pool_capacity_blocks{block_bytes=\"16\"}") != std::string::npos);
+    std::size_t headers = 0;
+    for (std::size_t at = 0; (at = before.find("# TYPE size_class_pool_live_blocks", at)) != std::string::npos; ++at)
+        ++headers;
+    CHECK(headers == 1); // One header for all size classes
+
+    std::ostringstream after; // The store is gone: its gauge must be too
+    writePrometheus(after);
+    CHECK(after.str().find("test_store_size") == std::string::npos);
+}
+
+// ---------- MetricsServer ----------
+#if defined(__unix__) || defined(__APPLE__)
+static int connectLoopback(unsigned short port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void metricsServerDropsSilentClient() {
+    MetricsServer server(0);
+    int silent = connectLoopback(server.port()); // Connects, never sends
+    CHECK(silent >= 0);
+
+    auto start = std::chrono::steady_clock::now();
+    int scraper = connectLoopback(server.port());
+    CHECK(scraper >= 0);
+    const char request[] = "GET /metrics HTTP/1.0\r\n\r\n";
+    CHECK(::send(scraper, request, sizeof(request) - 1, 0) > 0);
+    std::string response;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = ::recv(scraper, buffer, sizeof(buffer), 0)) > 0)
+        response.append(buffer, static_cast<std::size_t>(n));
+    double waited = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    CHECK(response.compare(0, 15, "HTTP/1.0 200 OK") == 0);
+    CHECK(response.find("houses_directed_total") != std::string::npos);
+    CHECK(waited < MetricsServer::clientTimeoutMs * 3); // Served once the silent client timed out
+
+    ::close(scraper);
+    ::close(silent);
+}
+#endif
+
+// ---------- ReadyBuffer ----------
+static void readyBufferCountsProducts() {
+    std::uint64_t trucks = factoryMetrics().trucksCreated.value();
+    ReadyBuffer<Transport, std::string> buffer(4);
+    buffer.registerType<Truck>("road");
+    buffer.start();
+    buffer.start(); // Second start is a no-op, not std::terminate
+    SpeculativeLogistics logistics(buffer, "road");
+    for (int i = 0; i < 10; ++i) {
+        std::unique_ptr<Transport> truck(logistics.createTransport());
+        CHECK(truck->deliver() == "Delivery by Truck");
+    }
+    buffer.stop();
+    CHECK(buffer.hits() + buffer.misses() == 10);
+    CHECK(factoryMetrics().trucksCreated.value() >= trucks + 10); // Plus any left ready
+
+    buffer.start(); // Restart after stop
+    ReadyBuffer<Transport, std::string>::Pointer truck = buffer.acquire("road");
+    CHECK(truck != nullptr);
+}
+
+// ---------- JsonWriter ----------
+static void jsonWriterEscaping() {
+    JsonWriter json;
+    json.beginObject();
+    json.key("text");
+    static const char raw[] = "quote\" back\\ nl\n tab\t cr\r bell\x07 nul\0!";
+    json.value(raw, sizeof(raw) - 1);
+    json.key("n");
+    json.value(42ull);
+    json.endObject();
+    json.endRecord();
+    CHECK(json.str() == "{\"text\":\"quote\\\" back\\\\ nl\\n tab\\t cr\\r bell\\u0007 nul\\u0000!\",\"n\":42}\n");
+
+    json.clear();
+    json.beginArray();
+    json.value("a");
+    json.beginObject();
+    json.endObject();
+    json.value(0ull);
+    json.endArray();
+    CHECK(json.str() == "[\"a\",{},0]");
+}
+
+// ---------- Payload Views ----------
+static void payloadViewLayout() {
+    // Same layout whether or not DP_CHECK_PAYLOAD_LIFETIME is on
+    CHECK(sizeof(PayloadView) == sizeof(const char*) + sizeof(std::size_t) + sizeof(std::weak_ptr<const int>));
+    CHECK(sizeof(PayloadOwner) == sizeof(std::shared_ptr<const int>));
+    CHECK(PayloadView().data() == nullptr); // Untracked views never assert
+    OrderBuffer buffer("a\nbc\n");
+    CHECK(buffer.orders().size() == 2);
+    CHECK(buffer.orders()[1].str() == "bc");
+}
+
+// ---------- Order Ingestion ----------
+static bool parses(const char* line, Order& order) {
+    static PayloadOwner owner;
+    return parseOrder(line, line + std::strlen(line), owner, order);
+}
+
+static void parseOrderAcceptReject() {
+    Order order;
+    CHECK(parses("{\"id\":\"o-1\",\"mode\":\"road\",\"payload\":\"20 crates\"}", order));
+    CHECK(order.mode == OrderMode::Road);
+    CHECK(order.id.str() == "o-1");
+    CHECK(order.payload.str() == "20 crates");
+
+    CHECK(parses(" { \"mode\" : \"sea\" , \"priority\" : 2 , \"rush\" : true , \"note\" : null } \r", order));
+    CHECK(order.mode == OrderMode::Sea);
+    CHECK(parses("{\"payload\":\"say \\\"hi\\\"\",\"mode\":\"sea\"}", order));
+    CHECK(order.payload.str() == "say \\\"hi\\\""); // Escapes stay raw
+
+    CHECK(!parses("", order));
+    CHECK(!parses("{}", order));
+    CHECK(!parses("{\"mode\":\"air\"}", order));
+    CHECK(!parses("{\"mode\":\"road\"", order));
+    CHECK(!parses("{\"mode\":\"road", order));
+    CHECK(!parses("{\"mode\":\"road\\", order)); // Ends in a backslash
+    CHECK(!parses("{\"mode\":\"road\",\"stops\":[1,2]}", order));
+    CHECK(!parses("[\"mode\",\"road\"]", order));
+    CHECK(!parses("{\"mode\":\"road\"} trailing", order));
+    CHECK(!parses("{\"mode\":\"road\"}}", order));
+    CHECK(!parses("{\"mode\":\"road\",}", order));
+    CHECK(!parses("{,\"mode\":\"road\"}", order));
+    CHECK(!parses("{\"mode\":\"road\",,\"id\":\"x\"}", order));
+    CHECK(!parses("{\"mode\":\"sea\",\"x\":tru}", order));
+    CHECK(!parses("{\"mode\":\"sea\",\"x\":truex}", order));
+    CHECK(!parses("{\"mode\":\"sea\",\"x\":}", order));
+    CHECK(!parses("{\"mode\":\"sea\",\"x\":01}", order));
+    CHECK(!parses("{\"mode\":\"sea\",\"x\":1.}", order));
+    CHECK(!parses("{\"mode\":\"sea\",\"x\":-}", order));
+    CHECK(!parses("{\"mode\":\"sea\",\"x\":1e}", order));
+    CHECK(parses("{\"mode\":\"sea\",\"a\":-0.5e+3,\"b\":0,\"c\":false,\"d\":12E2} \t", order));
+
+    PayloadOwner owner;
+    const char lines[] = "{\"mode\":\"road\"}\n\n{\"mode\":\"sea\"}\nnot json\n{\"mode\":\"road\"}";
+    OrderBatches batches = ingestOrders(lines, sizeof(lines) - 1, owner);
+    CHECK(batches.road.size() == 2);
+    CHECK(batches.sea.size() == 1);
+    CHECK(batches.rejected == 1);
+}
+
+// ---------- IdleTrimmer ----------
+static void idleTrimmerTrimsArena() {
+    TrivialArena arena(1024);
+    for (int i = 0; i < 100; ++i)
+        arena.create<PlainHouse>();
+    std::size_t grown = arena.bytesReserved();
+    CHECK(grown > 2 * 1024);
+
+    IdleTrimmer trimmer(std::chrono::seconds(30));
+    trimmer.watchArena(arena, 2);
+    IdleTrimmer::Clock::time_point start = IdleTrimmer::Clock::now();
+    CHECK(trimmer.poll(start + std::chrono::minutes(1)) == 1);
+    CHECK(arena.bytesReserved() == grown); // Every chunk still holds live objects
+
+    arena.reset();
+    CHECK(trimmer.poll(start + std::chrono::minutes(2)) == 0); // Reset counts as activity
+    CHECK(trimmer.poll(start + std::chrono::minutes(3)) == 1);
+    CHECK(arena.bytesReserved() == 2 * 1024);
+    CHECK(trimmer.poll(start + std::chrono::minutes(4)) == 0); // Not trimmed twice
+
+    arena.create<PlainHouse>()->addPart(BuildStep::Doors); // Still usable after trim
+    CHECK(trimmer.poll(start + std::chrono::minutes(5)) == 0);
+    CHECK(trimmer.poll(start + std::chrono::minutes(6)) == 1);
+    CHECK(arena.bytesReserved() == 2 * 1024);
+}
+
+static void idleTrimmerCompactsStore() {
+    SlotMap<int> store;
+    std::vector<SlotHandle> handles;
+    for (int i = 0; i < 100; ++i)
+        handles.push_back(store.emplace(i));
+    for (int i = 10; i < 100; ++i)
+        store.erase(handles[i]);
+    IdleTrimmer trimmer(std::chrono::seconds(30));
+    trimmer.watchStore(store);
+    IdleTrimmer::Clock::time_point start = IdleTrimmer::Clock::now();
+    CHECK(trimmer.poll(start + std::chrono::minutes(1)) == 1);
+    CHECK(store.report().slots == 10);
+    CHECK(store.contains(handles[9]));
+    store.emplace(-1); // Activity again: trimmed after the next quiet period
+    CHECK(trimmer.poll(start + std::chrono::minutes(2)) == 0);
+    CHECK(trimmer.poll(start + std::chrono::minutes(3)) == 1);
+}
+
+static void idleTrimmerWatchesSharedPoolOnce() {
+    static_assert(SizeClassOf<Truck>::value == SizeClassOf<ModernChair>::value, "Shared size class");
+    IdleTrimmer trimmer(std::chrono::seconds(30));
+    trimmer.watchPool<Truck>(256);
+    trimmer.watchPool<ModernChair>(512);
+    IdleTrimmer::Clock::time_point start = IdleTrimmer::Clock::now();
+    CHECK(trimmer.poll(start + std::chrono::minutes(1)) == 1);
+    CHECK(PoolFor<Truck>::instance().capacity() >= 512); // Larger retain wins
+}
+
+// ---------- Prewarming ----------
+static void prewarmSumsSharedSizeClass() {
+    PrewarmConfig warm;
+    warm.transports = 1000;
+    warm.chairs = 1000;
+    prewarmProducts(warm);
+    // Trucks, ships and both chairs share one pool: 4000 blocks, not 1000
+    CHECK(PoolFor<Truck>::instance().capacity() >= 4000);
+}
+
+// ---------- SamplingProfiler ----------
+#if defined(__linux__)
+static void previousProfHandler(int) {}
+
+static void samplingProfilerRestoresHandler() {
+    SamplingProfiler& profiler = SamplingProfiler::instance();
+    bool threw = false;
+    try {
+        profiler.start(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+    threw = false;
+    try {
+        profiler.start(1000001);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    struct sigaction mine;
+    std::memset(&mine, 0, sizeof(mine));
+    mine.sa_handler = &previousProfHandler;
+    sigemptyset(&mine.sa_mask);
+    struct sigaction original;
+    sigaction(SIGPROF, &mine, &original);
+
+    profiler.start(1); // 1 Hz is a whole-second interval, still valid
+    profiler.stop();
+
+    // Samples are taken, and the frame-pointer walk survives a busy loop
+    profiler.start(10000);
+    std::clock_t begin = std::clock();
+    volatile std::size_t spin = 0;
+    while (std::clock() - begin < CLOCKS_PER_SEC / 20)
+        spin = spin + 1;
+    profiler.stop();
+    CHECK(profiler.sampleCount() > 0);
+    std::ostringstream folded;
+    profiler.writeFolded(folded, "root");
+    CHECK(folded.str().compare(0, 5, "root;") == 0);
+
+    profiler.start(1000);
+    struct sigaction during;
+    sigaction(SIGPROF, nullptr, &during);
+    CHECK(during.sa_handler != &previousProfHandler);
+    profiler.stop();
+    profiler.stop(); // Second stop is a no-op
+    struct sigaction after;
+    sigaction(SIGPROF, nullptr, &after);
+    CHECK(after.sa_handler == &previousProfHandler);
+
+    sigaction(SIGPROF, &original, nullptr);
+}
+#endif
+
+// ---------- TrivialVector ----------
+static void trivialVectorSelfPushAtGrowth() {
+    TrivialVector<PlainHouse> houses;
+    PlainHouse first = {};
+    first.addPart(BuildStep::Windows);
+    houses.push_back(first);
+    while (houses.size() < houses.capacity())
+        houses.push_back(PlainHouse{});
+    houses.push_back(houses[0]); // Grows while reading from the old block
+    CHECK(houses.size() == 17);
+    CHECK(houses[16].partCount == 1);
+    CHECK(houses[16].parts[0] == BuildStep::Windows);
+}
+
+// ---------- ArenaHouseBuilder ----------
+static void arenaHouseBuilderRollback() {
+    TrivialArena arena;
+    ArenaHouseBuilder builder(arena);
+    Director director;
+    director.setBuilder(&builder);
+
+    director.buildMinimalHouse();
+    builder.finishHouse();
+    ArenaHouseBuilder::Checkpoint cp = builder.checkpoint();
+    director.buildFullHouse();
+    builder.finishHouse();
+    director.buildMinimalHouse(); // Left in progress
+    CHECK(builder.houses().size() == 2);
+
+    builder.rollback(cp);
+    CHECK(builder.houses().size() == 1);
+    CHECK(builder.houses()[0]->partCount == 2);
+
+    // Rolling back to a checkpoint taken mid-house restores its part count
+    builder.buildWalls();
+    ArenaHouseBuilder::Checkpoint mid = builder.checkpoint();
+    builder.buildDoors();
+    builder.buildWindows();
+    builder.rollback(mid);
+    builder.finishHouse();
+    CHECK(builder.houses().size() == 2);
+    CHECK(builder.houses()[1]->partCount == 1);
+    CHECK(builder.houses()[1]->parts[0] == BuildStep::Walls);
+}
+
+int main() {
+    slotMapStaleHandles();
+    slotMapCompaction();
+    taggedPtrNull();
+    concurrentHouseDeterministicOrder();
+    concurrentHouseCapacity();
+    cityBuilderBuildsInPlace();
+    recipeTrackerSuffixRebuild();
+    fanOutBuildersReturnHouses();
+    directorCountsRecipes();
+    gaugesUnregisterAndExportPools();
+#if defined(__unix__) || defined(__APPLE__)
+    metricsServerDropsSilentClient();
+#endif
+    readyBufferCountsProducts();
+    jsonWriterEscaping();
+    payloadViewLayout();
+    parseOrderAcceptReject();
+    trivialVectorSelfPushAtGrowth();
+    arenaHouseBuilderRollback();
+    idleTrimmerTrimsArena();
+    prewarmSumsSharedSizeClass();
+    idleTrimmerWatchesSharedPoolOnce();
+    idleTrimmerCompactsStore();
+#if defined(__linux__)
+    samplingProfilerRestoresHandler();
+#endif
+
+    std::printf("%d check(s) failed\n", failures);
+    return failures;
+}
@@ -0,0 +1,44 @@
+#include "TrainingWorkload.h"
+
+#include <iostream>
+#include <memory>
+#include <streambuf>
+
+#include "AbstractFactory.h"
+#include "Builder.h"
+#include "FactoryMethod.h"
+
+// Formats everything it is given, then throws it away
+class DiscardBuffer : public std::streambuf {
+protected:
+    int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+void runTrainingWorkload(std::size_t rounds) {
+    DiscardBuffer discard;
+    std::streambuf* console = std::cout.rdbuf(&discard);
+
+    RoadLogistics road;
+    SeaLogistics sea;
+    const Logistics* logistics[] = { &road, &road, &road, &sea }; // Mostly road
+    VictorianFactory victorian;
+    ModernFactory modern;
+    const FurnitureFactory* furniture[] = { &modern, &modern, &victorian };
+    SimpleHouseBuilder builder;
+    Director director;
+    director.setBuilder(&builder);
+
+    for (std::size_t i = 0; i < rounds; ++i) {
+        logistics[i % 4]->planDelivery();
+        showFurniture(*furniture[i % 3]);
+        if (i % 2)
+            director.buildFullHouse();
+        else
+            director.buildMinimalHouse();
+        std::unique_ptr<House> house(builder.getResult());
+        house->show();
+    }
+
+    std::cout.rdbuf(console);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+//
+// ===========================
+// Training Workload
+// ===========================
+//
+// Intent: A representative run of all three patterns for profile-guided
+// optimization (see scripts/pgo_build.sh) and for quick timing. It follows
+// the same paths as the demo - virtual creation and dispatch, Director
+// recipes - in the demo's proportions, with output discarded.
+//
+
+void runTrainingWorkload(std::size_t rounds);
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Builder.h"
+#include "TaggedPtr.h"
+
+//
+// ===========================
+// Trivial Product Variants
+// ===========================
+//
+// Intent: Plain-data versions of the products for bulk storage. They have no
+// vtable, no owned heap memory and no destructor work, so containers can move
+// them with memcpy and arenas can drop them without running destructors.
+//
+// Key Roles:
+// - PlainTransport / PlainChair / PlainHouse: trivially copyable products
+// - TrivialVector: growth by realloc (a bytewise relocation), no destructors
+// - TrivialArena: bump allocation; reset() is O(chunks), not O(objects)
+//
+
+// ---------- Plain Products ----------
+struct PlainTransport {
+    TransportKind kind;
+
+    const char* deliver() const {
+        return kind == TransportKind::Truck ? "Delivery by Truck" : "Delivery by Ship";
+    }
+};
+
+struct PlainChair {
+    ChairStyle style;
+
+    const char* type() const {
+        return style == ChairStyle::Victorian ? "Victorian Chair" : "Modern Chair";
+    }
+};
+
+struct PlainHouse {
+    static const std::size_t maxParts = 7;
+
+    std::uint8_t partCount;
+    BuildStep parts[maxParts];
+
+    void addPart(BuildStep part) {
+        if (partCount == maxParts)
+            throw std::length_error("PlainHouse: too many parts");
+        parts[partCount++] = part;
+    }
+
+    void show() const {
+        static const char* const names[] = { "Walls", "Doors", "Windows" };
+        std::cout << "[Builder] House with: ";
+        for (std::size_t i = 0; i < partCount; ++i)
+            std::cout << names[static_cast<int>(parts[i])] << " ";
+        std::cout << "\n";
+    }
+};
+
+template <class T>
+struct IsTrivialProduct {
+    static const bool value = std::is_trivially_copyable<T>::value
+        && std::is_trivially_destructible<T>::value;
+};
+
+static_assert(IsTrivialProduct<PlainTransport>::value, "PlainTransport must stay trivial");
+static_assert(IsTrivialProduct<PlainChair>::value, "PlainChair must stay trivial");
+static_assert(IsTrivialProduct<PlainHouse>::value, "PlainHouse must stay trivial");
+
+// ---------- Trivial Vector ----------
+template <class T>
+class TrivialVector {
+    static_assert(IsTrivialProduct<T>::value, "TrivialVector relocates with realloc");
+
+public:
+    TrivialVector() = default;
+    ~TrivialVector() { std::free(items); }
+
+    TrivialVector(const TrivialVector&) = delete;
+    TrivialVector& operator=(const TrivialVector&) = delete;
+
+    TrivialVector(TrivialVector&& other) noexcept
+        : items(other.items), count(other.count), reserved(other.reserved) {
+        other.items = nullptr;
+        other.count = other.reserved = 0;
+    }
+
+    void push_back(const T& value) {
+        if (count == reserved) {
+            T copy(value); // value may live in the block realloc is about to free
+            reserve(reserved ? reserved * 2 : 16);
+            std::memcpy(static_cast<void*>(items + count), &copy, sizeof(T));
+        } else {
+            std::memcpy(static_cast<void*>(items + count), &value, sizeof(T));
+        }
+        ++count;
+    }
+
+    void reserve(std::size_t n) {
+        if (n <= reserved)
+            return;
+        void* grown = std::realloc(items, n * sizeof(T)); // May move the bytes: fine for T
+        if (!grown)
+            throw std::bad_alloc();
+        items = static_cast<T*>(grown);
+        reserved = n;
+    }
+
+    void clear() { count = 0; } // Nothing to destroy
+
+    T& operator[](std::size_t i) { return items[i]; }
+    const T& operator[](std::size_t i) const { return items[i]; }
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return reserved; }
+
+    T* begin() { return items; }
+    T* end() { return items + count; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+
+private:
+    T* items = nullptr;
+    std::size_t count = 0;
+    std::size_t reserved = 0;
+};
+
+// ---------- Trivial Arena ----------
+class TrivialArena {
+public:
+    explicit TrivialArena(std::size_t chunkBytes = 64 * 1024) : chunkBytes(chunkBytes) {}
+
+    ~TrivialArena() {
+        for (void* chunk : chunks)
+            std::free(chunk);
+    }
+
+    TrivialArena(const TrivialArena&) = delete;
+    TrivialArena& operator=(const TrivialArena&) = delete;
+
+    template <class T, class... Args>
+    T* create(Args&&... args) {
+        static_assert(IsTrivialProduct<T>::value, "Arena reset never runs destructors");
+        void* memory = allocate(sizeof(T), alignof(T));
+        return new (memory) T{ std::forward<Args>(args)... };
+    }
+
+    // Position in the arena; release() frees everything created after it
+    struct Marker {
+        std::size_t chunk;
+        std::size_t offset;
+    };
+
+    Marker mark() const { return Marker{ current, offset }; }
+
+    // O(1): objects are trivial, so nothing needs to be visited
+    void release(Marker m) {
+        current = m.chunk;
+        offset = m.offset;
+        ++operations;
+    }
+
+    // Forgets every object at once; chunks are kept for reuse
+    void reset() {
+        current = 0;
+        offset = 0;
+        ++operations;
+    }
+
+    std::size_t bytesReserved() const { return chunks.size() * chunkBytes; }
+
+    // Creations, releases and resets so far; an idle arena's count stops moving
+    std::uint64_t activity() const { return operations; }
+
+    // Frees the chunks kept for reuse, keeping at least retainChunks and
+    // always the chunk in use
+    void trim(std::size_t retainChunks) {
+        std::size_t keep = retainChunks > current + 1 ? retainChunks : current + 1;
+        while (chunks.size() > keep) {
+            std::free(chunks.back());
+            chunks.pop_back();
+        }
+    }
+
+private:
+    void* allocate(std::size_t size, std::size_t alignment) {
+        if (size > chunkBytes)
+            throw std::length_error("TrivialArena: object larger than a chunk");
+        ++operations;
+        while (true) {
+            if (current < chunks.size()) {
+                std::size_t aligned = (offset + alignment - 1) / alignment * alignment;
+                if (aligned + size <= chunkBytes) {
+                    offset = aligned + size;
+                    return static_cast<unsigned char*>(chunks[current]) + aligned;
+                }
+                if (current + 1 < chunks.size()) { // Reuse a chunk from before reset()
+                    ++current;
+                    offset = 0;
+                    continue;
+                }
+            }
+            void* chunk = std::malloc(chunkBytes); // malloc alignment covers every product
+            if (!chunk)
+                throw std::bad_alloc();
+            chunks.push_back(chunk);
+            current = chunks.size() - 1;
+            offset = 0;
+        }
+    }
+
+    std::size_t chunkBytes;
+    std::vector<void*> chunks;
+    std::size_t current = 0;
+    std::size_t offset = 0;
+    std::uint64_t operations = 0;
+};
@@ -0,0 +1,26 @@
+#!/bin/sh
+#
+# Prints per-type creation rates from the USDT probes, once per second.
+# Local use only: attaches to a binary on this host, needs root and bpftrace.
+#
+#   scripts/creation_rates.sh <path-to-binary> [pid]
+#
+# Instrumentation.h emits the probe notes itself on x86-64 and AArch64 ELF
+# builds (through <sys/sdt.h> when the host has it), so no extra headers are
+# needed; the probes are absent only when built with -DDP_PROBES=OFF.
+#
+set -e
+BIN=${1:?usage: creation_rates.sh <path-to-binary> [pid]}
+PID_ARG=""
+[ -n "$2" ] && PID_ARG="-p $2"
+
+exec bpftrace $PID_ARG -e "
+usdt:$BIN:design_patterns:create_transport { @transports[str(arg0)] = count(); }
+usdt:$BIN:design_patterns:create_chair { @chairs[str(arg0)] = count(); }
+usdt:$BIN:design_patterns:get_result { @houses = count(); }
+interval:s:1 {
+    time(\"%H:%M:%S\n\");
+    print(@transports); print(@chairs); print(@houses);
+    clear(@transports); clear(@chairs); clear(@houses);
+}
+"